@@ -17,28 +17,136 @@ r
 de cinq ensembles de donnes.
 ---------------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
 #include <gng1106plplot.h>  // Donne des dfinitions pour utiliser la librarie PLplot
 #include <math.h>
+#ifdef _WIN32
+#include <windows.h>  // GetSystemInfo() pour le nombre de processeurs, projection de fichiers
+#else
+#include <unistd.h>  // sysconf() pour le nombre de processeurs
+#include <fcntl.h>
+#include <sys/mman.h>  // mmap() pour la projection du fichier de la table
+#include <sys/stat.h>
+#endif
 
 // Quelques dfinitions
 #define VRAI 1
 #define FAUX 0
 #define NBR_SAUVER 5 //nombre de sauvegardes permises dans le fichier
-#define TOLERANCE 1E-13 //tolerance pour la bissetion
 #define PRESQUE_0 1E-10 //borne minimale de la bissection
 #define HAUT 100000 //borne maximale pour la bissection
-#define TAILLE_MAX 100 //taille maximale des tableaux de donnes
+#define NBR_POINTS_MIN 2 //nombre minimal de diamtres  calculer
+#define NBR_POINTS_MAX 1E9 //nombre maximal de diamtres  calculer
 #define FICHIER_BIN "donneesFluide.bin"
+#define TAILLE_MEMBRE_ORIGINE 1672 //taille d'un membre de FICHIER_BIN au format d'origine (tableaux de 100 points en ligne)
+#define TAILLE_MEMBRE_POINTEURS 96 //taille d'un membre de FICHIER_BIN crit avec les pointeurs de DONNEES (64 bits)
+#define NBR_POINTS_ORIGINE 100 //nombre de diamtres des membres au format d'origine
+#define FICHIER_TABLE "tableFriction.bin" //table prcalcule, projete en mmoire en lecture seule
+#define FICHIER_TABLE_TEMP "tableFriction.%lu.tmp" //fichier crit puis renomm en FICHIER_TABLE (format : numro du processus)
+#define TAILLE_NOM_TEMP 64 //taille des noms de fichiers temporaires
+#define TABLE_MAGIQUE 0x46524354 //"TCRF" : identifie le fichier de la table
+#define TABLE_VERSION 1 //version du format du fichier de la table
+#define FICHIER_MEMO "memoFriction.bin" //facteurs de friction dj calculs, selon (rey, eps/d),  ct de FICHIER_BIN
+#define FICHIER_MEMO_TEMP "memoFriction.%lu.tmp" //fichier crit puis renomm en FICHIER_MEMO (format : numro du processus)
+#define MEMO_MAGIQUE 0x4F4D4346 //"FCMO" : identifie le fichier de la mmosation
+#define MEMO_VERSION 1 //version du format du fichier de la mmosation
+#define MEMO_CASES_MIN 4096 //nombre initial de cases de la table de hachage (puissance de 2)
+#define MEMO_CASES_MAX 4194304 //nombre maximal de cases; la table reste au plus  moiti pleine
+#define MEMO_BITS_IGNORES 4 //bits de poids faible de la mantisse ignors dans la cl (cart relatif < 2^-48)
 #define VALEUR_MIN_REY 4000 //valeur minimale du nombre de Reynolds
 #define IMPOSSIBLE -1 //valeur pour drapeau lorsque le facteur de friction impossible
+#define NON_CONVERGE -2 //valeur pour drapeau lorsque la mthode itrative n'a pas converg
+#define STATUT_OK 0 //calcul par lot : facteur de friction calcul
+#define STATUT_SANS_RACINE 1 //calcul par lot : l'quation Colebrook n'a pas de racine
+#define STATUT_ENTREE_INVALIDE 2 //calcul par lot : rey < VALEUR_MIN_REY, rugosit ngative ou non numrique
+#define STATUT_NON_CONVERGE 3 //calcul par lot : la mthode itrative n'a pas converg
+#define STATUT_MEMOIRE 4 //balayage : mmoire insuffisante pour les tableaux
+#define BISSECTION 1 //mthode de la bissection sur f
+#define NEWTON 2 //mthode de Newton-Raphson sur x = 1/sqrt(f)
+#define OMEGA_WRIGHT 3 //solution exacte par la fonction omga de Wright (W de Lambert)
+#define HAALAND 4 //corrlation explicite de Haaland
+#define SWAMEE_JAIN 5 //corrlation explicite de Swamee-Jain
+#define SERGHIDES 6 //corrlation explicite de Serghides
+#define ZIGRANG_SYLVESTER 7 //corrlation explicite de Zigrang-Sylvester
+#define GOUDAR_SONNAD 8 //corrlation explicite de Goudar-Sonnad
+#define TABLE_BICUBIQUE 9 //interpolation bicubique dans une table prcalcule de (rey, eps/d)
+#define CHEBYSHEV 10 //polynmes de Tchebychev par morceaux ajusts sur un domaine choisi
+#define ITER_OMEGA 2 //nombre fixe de raffinements pour la fonction omga de Wright
+#define ECART_GRAINE 0.01 //demi-largeur relative de l'intervalle de bissection autour de la graine
+#define ITER_GRAINE 5 //nombre maximal d'itrations de Newton  partir de la graine
+#define LARGEUR_VECT 8 //nombre de diamtres traits  la fois par le noyau vectoriel
+#define LARGEUR_VECT_FLOAT 16 //nombre de diamtres traits  la fois par le noyau en simple prcision
+#define ITER_FLOAT 2 //nombre fixe de pas de Newton en simple prcision (voir calculNewtonBlocFloat)
+#define PRECISION_DOUBLE 1 //Newton en double prcision
+#define PRECISION_SIMPLE 2 //Newton en simple prcision (float), erreur relative d'environ 1E-6
+#define PRECISION_RAFFINEE 3 //Newton en simple prcision, puis un pas de Newton en double
+#define NOYAU_AUTO 0 //noyau de Newton : le meilleur que le processeur supporte
+#define NOYAU_SCALAIRE 1 //noyau de Newton : aucun noyau vectoriel, calculNewton() point par point
+#define NOYAU_GENERIQUE 2 //noyau de Newton : vectoriel, jeu d'instructions de base de la compilation
+#define NOYAU_SSE42 3 //noyau de Newton : vectoriel, SSE4.2
+#define NOYAU_AVX2 4 //noyau de Newton : vectoriel, AVX2 et FMA
+#define NOYAU_AVX512 5 //noyau de Newton : vectoriel, AVX-512
+#define TAILLE_LIGNE_CACHE 64 //taille d'une ligne de cache en octets
+#define POINTS_MIN_PAR_FIL 1024 //nombre minimal de diamtres confis  chaque fil d'excution
+#define NBR_FILS_MAX 256 //nombre maximal de fils d'excution
+#define STATIQUE 1 //ordonnancement : un intervalle contigu fixe par fil
+#define VOL_TACHES 2 //ordonnancement : tranches dans une file par fil, avec vol de tches
+#define TAILLE_TRANCHE 512 //nombre de diamtres par tranche pour le vol de tches
+#define UNIFORME 1 //chantillonnage : diamtres galement espacs
+#define ADAPTATIF 2 //chantillonnage : points ajouts l o la courbure est forte
+#define GRILLE_LINEAIRE 1 //grille des diamtres : pas constant entre dmin et dmax
+#define GRILLE_LOG 2 //grille des diamtres : pas constant en log(d) entre dmin et dmax
+#define GRILLE_GEOMETRIQUE 3 //grille des diamtres : dmin*raison^k jusqu' dmax
+#define GRILLE_LISTE 4 //grille des diamtres : liste entre par l'utilisateur
+#define NBR_AXES 5 //nombre de paramtres de la grille multidimensionnelle
+#define AXE_DEBIT 0 //axe du dbit (varie le plus lentement)
+#define AXE_VISCOSITE 1 //axe de la viscosit
+#define AXE_DENSITE 2 //axe de la densit
+#define AXE_RUGOSITE 3 //axe de la rugosit
+#define AXE_DIAMETRE 4 //axe du diamtre (varie le plus vite, contigu en mmoire)
+#define TAILLE_BLOC_GRILLE 2048 //points par bloc de la grille : entres et statuts d'un bloc tiennent dans le cache L2
+#define POINTS_GRILLE_MAX 4E9 //nombre maximal de points de la grille multidimensionnelle
+#define SANS_FLUX 0 //balayage : rsultats conservs dans dtbl et ftbl
+#define FLUX_FICHIER 1 //balayage en flux : paires (diamtre, f) crites dans FICHIER_FLUX
+#define FLUX_SORTIE 2 //balayage en flux : paires (diamtre, f) crites sur la sortie standard
+#define FLUX_REDUCTION 3 //balayage en flux : seulement le minimum, le maximum et le graphique
+#define FICHIER_FLUX "balayage.csv" //fichier texte du balayage en flux
+#define TAILLE_MORCEAU 4096 //nombre de diamtres calculs et envoys  la fois en flux
+#define NBR_POINTS_TRACE 2000 //nombre maximal de points conservs pour le graphique d'un balayage en flux
+#define REUTILISATION_AUCUNE 0 //recalcul incrmental : tout est recalcul
+#define REUTILISATION_GRILLE 1 //recalcul incrmental : seuls les diamtres sont repris
+#define REUTILISATION_TOTALE 2 //recalcul incrmental : diamtres et facteurs de friction repris sans rsolution
+#define POINTS_INITIAUX 17 //nombre de diamtres galement espacs au dpart de l'chantillonnage adaptatif
+#define TOLERANCE_ECHANTILLON 1E-4 //erreur relative d'interpolation linaire vise par dfaut
+#define LN2 0.69314718055994530942 //logarithme naturel de 2
+#define RACINE_2 1.41421356237309504880 //racine carre de 2
+#define SEUIL_ERREUR 1E-3 //erreur relative acceptable pour une corrlation explicite
+#define TOLERANCE_ABS 0 //tolrance absolue sur f par dfaut pour les mthodes itratives
+#define TOLERANCE_REL 2E-12 //tolrance relative sur f par dfaut pour les mthodes itratives
+#define ITER_MAX 100 //nombre maximal d'itrations par point par dfaut (la bissection en demande environ 60)
+#define LN10 2.30258509299404568402 //logarithme naturel de 10
+#define DEUX_SUR_LN10 0.86858896380650365530 //2/ln(10), pour crire 2*log10(z) = DEUX_SUR_LN10*ln(z)
+#define TABLE_REY_MAX 1E8 //nombre de Reynolds maximal couvert par la table (le minimal est VALEUR_MIN_REY)
+#define TABLE_RUG_MAX 0.05 //rugosit relative maximale couverte par la table (la minimale est 0)
+#define TABLE_DECALAGE 1E-8 //dcalage de la rugosit relative avant le logarithme, pour couvrir eps/d = 0
+#define TABLE_NOEUDS_MIN 4 //nombre minimal de noeuds par dcade de la table
+#define TABLE_NOEUDS_MAX 200 //nombre maximal de noeuds par dcade de la table
+#define DEGRE_CHEB 10 //degr des polynmes de Tchebychev selon chaque axe
+#define NBR_COEF_CHEB (DEGRE_CHEB + 1) //nombre de coefficients (et de noeuds) selon chaque axe
+#define NBR_VALIDATION 100000 //nombre de points alatoires pour valider le substitut
 
 
 typedef struct
 {
     double rey; //nombre de Reynolds
     double dmax, dmin; //diamtre maximal et minimal
-    double dtbl[TAILLE_MAX]; //tableau pour ltendu du diamtre
-    double ftbl[TAILLE_MAX]; //tableau des facteurs de friction
+    int nbrPoints; //nombre de diamtres  calculer (taille des tableaux)
+    double *dtbl; //tableau allou pour ltendu du diamtre (non sauvegard)
+    double *ftbl; //tableau allou des facteurs de friction (non sauvegard)
     double eps; //rugosit
     double ro; //densit
     double mu; //viscosit
@@ -48,27 +156,420 @@ typedef struct
 
 } DONNEES;
 
+//membre de FICHIER_BIN : les entres de DONNEES en types de taille fixe, sans pointeur ni remplissage,
+//pour que le fichier ne dpende pas de la taille des pointeurs
+typedef struct
+{
+    double rey; //nombre de Reynolds
+    double dmax, dmin; //diamtre maximal et minimal
+    double eps; //rugosit
+    double ro; //densit
+    double mu; //viscosit
+    double debit; //dbit du flux
+    double vit; //vitesse
+    int32_t nbrPoints; //nombre de diamtres  calculer
+    int32_t estVide; //VRAI si le membre est vide
+} ENREGISTREMENT;
+
+//erreur d'un balayage des diamtres, rendue par remplirTableaux() plutt que de redemander les donnes
+typedef struct
+{
+    int code; //STATUT_OK, STATUT_SANS_RACINE, STATUT_ENTREE_INVALIDE, STATUT_NON_CONVERGE ou STATUT_MEMOIRE
+    double d; //diamtre du point fautif (0 si l'erreur ne concerne pas un point)
+    double rey; //nombre de Reynolds du point fautif
+    double rugRel; //rugosit relative eps/d du point fautif
+
+} ERREUR_BALAYAGE;
+
+//table prcalcule de x = 1/sqrt(f) sur une grille uniforme en u = log10(rey) et v = log10(eps/d + TABLE_DECALAGE)
+typedef struct
+{
+    int noeudsParDecade; //densit de la grille
+    int nbrRey, nbrRug; //nombre de noeuds selon u et selon v
+    double uMin, du; //premier noeud et pas selon u
+    double vMin, dv; //premier noeud et pas selon v
+    double *xtbl; //valeurs aux noeuds, xtbl[i*nbrRug + j] pour le noeud (i, j) (NULL si non construite)
+    double erreurMax; //erreur relative maximale de f, mesure au centre de chaque cellule
+    void *projection; //fichier projet en mmoire qui contient xtbl, ou NULL si xtbl est allou
+    size_t tailleProjection; //taille du fichier projet
+
+} TABLE_FRICTION;
+
+//en-tte de FICHIER_TABLE, suivi des nbrRey*nbrRug valeurs de xtbl (ordre des octets de la machine)
+typedef struct
+{
+    uint32_t magique; //TABLE_MAGIQUE
+    uint32_t version; //TABLE_VERSION
+    int32_t noeudsParDecade, nbrRey, nbrRug;
+    int32_t reserve; //aligne la suite sur 8 octets
+    double reyMin, reyMax, rugMax, decalage; //domaine de la table, vrifi  la lecture
+    double uMin, du, vMin, dv;
+    double erreurMax;
+
+} ENTETE_TABLE;
+
+//substitut de Tchebychev de x = 1/sqrt(f), en u = log10(rey) et v = log10(eps/d + TABLE_DECALAGE),
+//avec un morceau par dcade selon chaque axe
+typedef struct
+{
+    double reyMin, reyMax, rugMin, rugMax; //domaine choisi par l'utilisateur
+    double uMin, vMin; //coin du domaine en u et v
+    double du, dv; //largeur d'un morceau selon u et v
+    int nbrU, nbrV; //nombre de morceaux selon u et v
+    double *coef; //NBR_COEF_CHEB^2 coefficients par morceau (NULL si non ajust), voir ajusterSubstitut()
+    double erreurMax; //erreur relative maximale de f sur l'ensemble de validation
+
+} SUBSTITUT;
+
+//critre d'arrt des mthodes itratives : |erreur sur f| <= tolAbs + tolRel*f, en au plus iterMax itrations
+typedef struct
+{
+    double tolAbs; //tolrance absolue sur f
+    double tolRel; //tolrance relative sur f
+    int iterMax; //nombre maximal d'itrations par point
+
+} CRITERE;
+
+//rsultats supplmentaires par point du balayage, allous seulement si le suivi est demand
+typedef struct
+{
+    int *evaltbl; //nombre d'valuations de Colebrook (itrations) utilises pour chaque point
+    double *residutbl; //rsidu final |g(x)| de Colebrook en x = 1/sqrt(f) pour chaque point
+    double *dfdDtbl; //sensibilit df/dd de chaque point (eps et dbit constants)
+    double *dfdReytbl; //sensibilit df/drey de chaque point
+    double *dfdEpstbl; //sensibilit df/deps de chaque point
+    double *reytbl; //nombre de Reynolds de chaque point, si calcul  chaque diamtre
+    double *vittbl; //vitesse de chaque point, si le nombre de Reynolds est calcul  chaque diamtre
+    int nbrTraces; //balayage en flux : nombre de points de dtbl et ftbl  tracer, 0 sinon
+    double fMin, fMax; //balayage en flux : extrmes de f sur tous les points, tenus au fil du calcul
+
+} RESULTATS;
+
+//dernier balayage russi et entres dont dpendent ses tableaux, pour le recalcul incrmental (voir comparerCache())
+typedef struct
+{
+    int valide; //drapeau : dtbl et ftbl correspondent aux entres ci-dessous
+    //entres dont dpendent les diamtres
+    int grille, echantillonnage; //grille et chantillonnage des diamtres
+    int nbrDemandes; //nombre de diamtres demand (avant l'chantillonnage adaptatif)
+    double dmin, dmax, raison, tolEchantillon;
+    //entres dont dpendent les facteurs de friction, en plus des diamtres
+    double eps; //rugosit
+    int reyVariable; //nombre de Reynolds calcul  chaque diamtre (ro, mu et debit) ou constant (rey)
+    double rey, ro, mu, debit;
+    int methode, precision; //mthode de rsolution et prcision de Newton
+    CRITERE critere; //critre d'arrt des mthodes itratives
+    double paramMethode[4]; //paramtres de la table ou du substitut utilis, 0 sinon
+    //rsultats
+    int nbrPoints; //nombre de diamtres calculs
+    double *dtbl, *ftbl; //copies des diamtres et des facteurs de friction (NULL si non allous)
+    long nbrEval; //nombre d'valuations de Colebrook qui ont produit ftbl
+
+} CACHE_BALAYAGE;
+
+//entre de la mmosation : cl canonique (rey, eps/d) et facteur de friction
+typedef struct
+{
+    double rey; //nombre de Reynolds canonique (voir cleMemo()), 0 si la case est vide
+    double rugRel; //rugosit relative canonique
+    double f; //facteur de friction
+
+} ENTREE_MEMO;
+
+//en-tte de FICHIER_MEMO, suivi des nbrEntrees entres (ordre des octets de la machine)
+typedef struct
+{
+    uint32_t magique; //MEMO_MAGIQUE
+    uint32_t version; //MEMO_VERSION
+    int64_t nbrEntrees; //nombre d'entres qui suivent
+    double tolAbs, tolRel; //critre d'arrt avec lequel les entres ont t calcules
+    int32_t iterMax;
+    int32_t reserve; //aligne la suite sur 8 octets
+
+} ENTETE_MEMO;
+
+//mmosation persistante du facteur de friction, table de hachage  adressage ouvert
+typedef struct
+{
+    ENTREE_MEMO *cases; //cases de la table (NULL si non charge)
+    long nbrCases; //nombre de cases, puissance de 2
+    long nbrEntrees; //nombre de cases occupes
+    CRITERE critere; //critre d'arrt de toutes les entres; la table ne sert qu'avec ce critre
+    pthread_rwlock_t verrou; //recherches simultanes, insertions exclusives
+    long nbrTrouves, nbrManques; //compteurs du dernier balayage (incrments atomiques)
+    long nbrNouveaux; //entres ajoutes depuis la dernire criture de FICHIER_MEMO
+
+} MEMO;
+
+//axe de la grille multidimensionnelle : valeurs d'un paramtre de DONNEES
+typedef struct
+{
+    double min, max; //tendue de l'axe (min seulement si nbr = 1)
+    int nbr; //nombre de valeurs, 1 pour un paramtre fixe
+    int espacement; //GRILLE_LINEAIRE ou GRILLE_LOG
+    double *valeurs; //les nbr valeurs de l'axe, en ordre croissant
+
+} AXE;
+
+//grille dense du facteur de friction sur le produit cartsien des axes; le dernier axe varie le plus vite
+typedef struct
+{
+    AXE axes[NBR_AXES]; //axes, indics par AXE_DEBIT ... AXE_DIAMETRE
+    int64_t pas[NBR_AXES]; //pas de l'indice linaire selon chaque axe : ftbl[somme de i[k]*pas[k]]
+    int64_t nbrPoints; //produit des nombres de valeurs des axes (jusqu' POINTS_GRILLE_MAX, au-del de 32 bits)
+    double *ftbl; //facteurs de friction (IMPOSSIBLE si le point n'a pas de solution), NULL si non allou
+    int64_t nbrStatut[4]; //nombre de points de chaque statut (STATUT_OK ... STATUT_NON_CONVERGE)
+    int64_t iMin, iMax; //indices linaires du plus petit et du plus grand facteur de friction
+    int64_t nbrEval; //nombre total d'valuations de Colebrook
+
+} GRILLE_PARAMETRES;
+
+//puits du balayage en flux : reoit chaque morceau de nbr paires (diamtre, f) dans l'ordre
+typedef void (*PUITS)(const double [], const double [], int, void *);
+
+//noyau vectoriel de Newton (voir calculNewtonBloc)
+typedef int (*NOYAU_NEWTON)(const double [], const double [], double [], double, const CRITERE *);
+
+typedef struct
+{
+    int methode; //mthode de rsolution de l'quation Colebrook (BISSECTION, NEWTON, OMEGA_WRIGHT ou corrlation explicite)
+    long nbrEvaluations; //nombre d'valuations de Colebrook lors du dernier appel  calculFriction (ou total d'un lot)
+    int continuation; //drapeau : chaque point part de la solution du point prcdent
+    double graine; //solution du point prcdent pour la continuation (0 si aucune)
+    int nbrFils; //nombre de fils d'excution pour le balayage des diamtres
+    int ordonnancement; //partage du travail entre les fils (STATIQUE ou VOL_TACHES)
+    TABLE_FRICTION *tablePtr; //table utilise par la mthode TABLE_BICUBIQUE
+    SUBSTITUT *substitutPtr; //substitut utilis par la mthode CHEBYSHEV
+    int noyau; //noyau de Newton demand (NOYAU_AUTO ou un noyau prcis)
+    int noyauChoisi; //noyau de Newton utilis, jamais NOYAU_AUTO
+    NOYAU_NEWTON noyauNewton; //fonction du noyau utilis, ou NULL pour NOYAU_SCALAIRE
+    int precision; //prcision du noyau de Newton (PRECISION_DOUBLE, PRECISION_SIMPLE ou PRECISION_RAFFINEE)
+    CRITERE critere; //critre d'arrt des mthodes itratives
+    int suivi; //drapeau : conserve les valuations et le rsidu de chaque point dans resPtr
+    int sensibilites; //drapeau : calcule df/dd, df/drey et df/deps de chaque point dans resPtr
+    int echantillonnage; //rpartition des diamtres (UNIFORME ou ADAPTATIF)
+    double tolEchantillon; //erreur relative d'interpolation vise par l'chantillonnage adaptatif
+    int grille; //rpartition de base des diamtres (GRILLE_LINEAIRE, GRILLE_LOG, GRILLE_GEOMETRIQUE ou GRILLE_LISTE)
+    double raison; //rapport entre deux diamtres successifs de la grille gomtrique
+    double *listetbl; //diamtres de la grille GRILLE_LISTE, en ordre croissant
+    int nbrListe; //nombre de diamtres de listetbl
+    int reyVariable; //drapeau : nombre de Reynolds et vitesse calculs  chaque diamtre plutt qu' dmax
+    int flux; //sortie du balayage (SANS_FLUX, FLUX_FICHIER, FLUX_SORTIE ou FLUX_REDUCTION)
+    RESULTATS *resPtr; //rsultats supplmentaires par point
+    GRILLE_PARAMETRES *grillePtr; //grille multidimensionnelle de paramtres
+    CACHE_BALAYAGE *cachePtr; //dernier balayage russi, pour le recalcul incrmental (NULL si aucun)
+    const double *anciennetbl; //facteurs de friction repris tels quels du balayage prcdent, ou NULL
+    int memoisation; //drapeau : Newton et la bissection consultent et compltent memoPtr
+    MEMO *memoPtr; //mmosation persistante du facteur de friction
+
+} OPTIONS;
+
+//file de tranches d'un fil pour le vol de tches, seule sur sa ligne de cache
+typedef struct
+{
+    pthread_mutex_t verrou; //protge premiere et derniere
+    int premiere, derniere; //tranches restantes [premiere, derniere) : le propritaire prend au dbut, les voleurs  la fin
+
+} __attribute__((aligned(TAILLE_LIGNE_CACHE))) DEQUE;
+
+typedef struct
+{
+    DONNEES *dPtr; //donnes du balayage (chaque fil n'crit que dans sa partie de ftbl)
+    OPTIONS options; //copie prive des options, car graine et nbrEvaluations changent
+    int debut, fin; //intervalle d'indices [debut, fin) confi au fil (STATIQUE)
+    int id; //numro du fil
+    int nbrFils; //nombre total de fils
+    DEQUE *deques; //files de tranches de tous les fils (VOL_TACHES)
+    int *bornes; //indice du premier diamtre de chaque tranche, plus la fin (VOL_TACHES)
+    int echec; //indice du premier point sans racine calcul par le fil, ou -1
+    long totalEval; //nombre d'valuations de Colebrook du fil
+    int nbrPointsCalcules; //nombre de diamtres calculs par le fil
+    int nbrVols; //nombre de tranches voles  d'autres fils
+
+} TRAVAIL;
+
+//travail d'un fil pour la grille multidimensionnelle, seul sur sa ligne de cache
+typedef struct
+{
+    GRILLE_PARAMETRES *gPtr; //grille calcule (chaque bloc n'est crit que par un fil)
+    OPTIONS options; //copie prive des options
+    pthread_mutex_t *verrouPtr; //protge prochainPtr
+    int64_t *prochainPtr; //prochain bloc  calculer, partag par les fils
+    int64_t nbrBlocs; //nombre total de blocs
+    int64_t nbrStatut[4]; //nombre de points de chaque statut calculs par le fil
+    int64_t iMin, iMax; //indices du plus petit et du plus grand facteur de friction du fil, ou -1
+    int64_t totalEval; //nombre d'valuations de Colebrook du fil
+
+} __attribute__((aligned(TAILLE_LIGNE_CACHE))) TRAVAIL_GRILLE;
+
+//vecteurs de LARGEUR_VECT lments (extension de gcc) : 4 registres SSE2, 2 AVX2 ou 1 AVX-512
+typedef double VECT_DOUBLE __attribute__((vector_size(LARGEUR_VECT*sizeof(double))));
+typedef long long VECT_ENTIER __attribute__((vector_size(LARGEUR_VECT*sizeof(long long))));
+typedef float VECT_FLOAT __attribute__((vector_size(LARGEUR_VECT_FLOAT*sizeof(float))));
+typedef int VECT_ENTIER_FLOAT __attribute__((vector_size(LARGEUR_VECT_FLOAT*sizeof(int))));
+
+
+//Noyaux spcialiss de Newton  nombre fixe d'itrations (voir la description avant DEFINIR_COLEBROOK_FIXE)
+#define DEPART_POINT_FIXE(TYPE, LOG, a, b) (-(TYPE)DEUX_SUR_LN10*LOG((a) + (TYPE)8.0*(b)))
+
+#define DEFINIR_COLEBROOK_FIXE(NOM, TYPE, LOG, NBR_ITER, DEPART) \
+static inline TYPE NOM(TYPE rey, TYPE rugRel) \
+{ \
+    TYPE a = rugRel/(TYPE)3.7; /*terme de rugosit*/ \
+    TYPE b = (TYPE)2.51/rey; /*terme visqueux*/ \
+    TYPE x = DEPART(TYPE, LOG, a, b); /*estimation de 1/sqrt(f)*/ \
+    TYPE terme; /*argument du logarithme*/ \
+    int iter; \
+    _Pragma("GCC unroll 8") \
+    for(iter = 0; iter < NBR_ITER; iter = iter + 1) \
+    { \
+        terme = a + b*x; \
+        x = x - (x + (TYPE)DEUX_SUR_LN10*LOG(terme))/((TYPE)1.0 + (TYPE)DEUX_SUR_LN10*b/terme); \
+    } \
+    return((TYPE)1.0/(x*x)); \
+}
+
 
 // Prototypes des fonctions
-void obtientDonnees(DONNEES *, DONNEES [], FILE *);
-void choixDonnees(DONNEES [], DONNEES *, FILE *);
-void entrerDonnees(DONNEES *, DONNEES [], FILE *);
+void obtientDonnees(DONNEES *, DONNEES [], FILE *, OPTIONS *);
+int entrerGrille(DONNEES *, OPTIONS *, ERREUR_BALAYAGE *);
+void demandeAxe(AXE *, int);
+int initAxe(AXE *, double, double, int, int);
+int allouerGrille(GRILLE_PARAMETRES *);
+int64_t calculerGrille(GRILLE_PARAMETRES *, OPTIONS *);
+void *travailleurGrille(void *);
+int64_t indiceGrille(GRILLE_PARAMETRES *, const int []);
+void coordonneesGrille(GRILLE_PARAMETRES *, int64_t, int []);
+void afficheGrille(GRILLE_PARAMETRES *, double);
+int extraireCoupe(GRILLE_PARAMETRES *, DONNEES *);
+void libererGrille(GRILLE_PARAMETRES *);
+char *nomAxe(int);
+char *uniteAxe(int);
+int choixDonnees(DONNEES [], DONNEES *, FILE *, OPTIONS *, ERREUR_BALAYAGE *);
+int entrerDonnees(DONNEES *, DONNEES [], FILE *, OPTIONS *, ERREUR_BALAYAGE *);
 void afficheDonnees(DONNEES []);
 void sauverDonnees(DONNEES *, DONNEES [], FILE *);
 int demandeReboot();
 int verifieDiam(DONNEES *);
+int demandeNbrPoints();
+int verifieNbrPoints(double);
+int allouerTableaux(DONNEES *);
+void *reallouerTableau(void *, int64_t, size_t);
+void libererTableaux(DONNEES *);
 int getValeurPositive(double);
 int calculerRey(DONNEES *);
-int remplirTableaux(DONNEES *, DONNEES [], FILE *);
-double calculFriction(DONNEES *, double, DONNEES [], FILE *);
-double calculColebrook(double, double,  DONNEES *);
-double getMin(double []);
-double getMax(double []);
-void plot(DONNEES *);
+int remplirTableaux(DONNEES *, OPTIONS *, ERREUR_BALAYAGE *);
+int verifierFaisabilite(DONNEES *, OPTIONS *, ERREUR_BALAYAGE *);
+void afficheErreurBalayage(ERREUR_BALAYAGE *);
+void signatureCache(CACHE_BALAYAGE *, DONNEES *, OPTIONS *);
+int comparerCache(CACHE_BALAYAGE *, DONNEES *, OPTIONS *);
+void memoriserCache(CACHE_BALAYAGE *, DONNEES *, OPTIONS *, int, long);
+void afficheReutilisation(CACHE_BALAYAGE *, int, DONNEES *, long);
+void libererCache(CACHE_BALAYAGE *);
+int ouvrirMemo(MEMO *, const CRITERE *);
+long lireMemo(MEMO *);
+int ecrireMemo(MEMO *);
+static inline uint64_t cleMemo(double);
+static inline long caseMemo(MEMO *, double, double);
+double chercherMemo(MEMO *, double, double, const CRITERE *);
+void insererMemo(MEMO *, double, double, double, const CRITERE *);
+int placerMemo(MEMO *, double, double, double);
+int agrandirMemo(MEMO *);
+int memeCritere(const CRITERE *, const CRITERE *);
+void choixMemo(OPTIONS *);
+void chargerMemo(MEMO *, const CRITERE *);
+void afficheMemo(MEMO *);
+void libererMemo(MEMO *);
+int resoudreIntervalle(DONNEES *, OPTIONS *, int, int, long *);
+int echantillonnageAdaptatif(DONNEES *, OPTIONS *, long *);
+double erreurInterpolation(const double [], const double [], int, int);
+void insererMilieux(double [], double [], int, int, const int []);
+void insererMilieuxEntier(int [], int [], int, int, const int []);
+int comparerDecroissant(const void *, const void *);
+int comparerCroissant(const void *, const void *);
+int preparerGrille(DONNEES *, OPTIONS *);
+void remplirDiametres(DONNEES *, OPTIONS *, int);
+double diametreGrille(DONNEES *, OPTIONS *, int, int);
+int balayageFlux(DONNEES *, OPTIONS *, PUITS, void *, long *);
+void puitsTexte(const double [], const double [], int, void *);
+void choixFlux(OPTIONS *);
+char *nomFlux(int);
+static inline double reyPoint(DONNEES *, OPTIONS *, double);
+void choixGrille(OPTIONS *);
+char *nomGrille(int);
+int balayageParallele(DONNEES *, OPTIONS *, long *);
+void *travailleur(void *);
+void *travailleurVol(void *);
+int obtenirTranche(TRAVAIL *, int *);
+void afficheStatsFils(TRAVAIL [], int);
+int aligneIndice(int, int);
+int nbrProcesseurs();
+double chrono();
+double calculFriction(double, double, OPTIONS *);
+long calculFrictionLot(const double [], const double [], double [], int [], long, OPTIONS *);
+double calculBissection(double, double, long *, double, const CRITERE *);
+double calculNewton(double, double, long *, double, const CRITERE *);
+void initCritere(CRITERE *);
+void choixCritere(CRITERE *);
+int allouerResultats(RESULTATS *, int, OPTIONS *);
+void libererResultats(RESULTATS *);
+void afficheSuivi(DONNEES *, RESULTATS *);
+void afficheSensibilites(DONNEES *, RESULTATS *);
+static inline int corpsNewtonBloc(const double [], const double [], double [], double, const CRITERE *) __attribute__((always_inline));
+int calculNewtonBloc(const double [], const double [], double [], double, const CRITERE *);
+#if defined(__x86_64__) || defined(__i386__)
+int calculNewtonBlocSSE42(const double [], const double [], double [], double, const CRITERE *);
+int calculNewtonBlocAVX2(const double [], const double [], double [], double, const CRITERE *);
+int calculNewtonBlocAVX512(const double [], const double [], double [], double, const CRITERE *);
+#endif
+static inline void log10Vect(VECT_DOUBLE *, VECT_DOUBLE *) __attribute__((always_inline));
+int calculNewtonBlocFloat(const double [], const double [], double [], int);
+static inline void lnVectFloat(VECT_FLOAT *, VECT_FLOAT *);
+char *nomPrecision(int);
+int precisionNewton(OPTIONS *);
+void choisirNoyau(OPTIONS *);
+int noyauSupporte(int);
+char *nomNoyau(int);
+void choixNoyau(OPTIONS *);
+static inline double colebrookDouble3(double, double);
+static inline long double colebrookLongDouble4(long double, long double);
+double calculExplicite(int, double, double);
+double calculOmega(double, double);
+double omegaWright(double);
+int construireTable(TABLE_FRICTION *, int);
+double interpolerTable(TABLE_FRICTION *, double, double);
+static inline void poidsLagrange(double, double []);
+void libererTable(TABLE_FRICTION *);
+int ecrireTable(TABLE_FRICTION *);
+unsigned long numeroProcessus();
+int lireTable(TABLE_FRICTION *, int);
+void *projeterFichier(char [], size_t *);
+void libererProjection(void *, size_t);
+void choixSubstitut(SUBSTITUT *);
+int ajusterSubstitut(SUBSTITUT *);
+double evaluerSubstitut(SUBSTITUT *, double, double);
+void evaluerSubstitutLot(SUBSTITUT *, const double [], const double [], double [], long);
+double validerSubstitut(SUBSTITUT *, double *, double *);
+void libererSubstitut(SUBSTITUT *);
+void choixTable(TABLE_FRICTION *);
+void afficheErreurExplicite(DONNEES *, OPTIONS *);
+char *nomMethode(int);
+double calculColebrook(double, double, double);
+double calculColebrookX(double, double, double, double *);
+void calculSensibilites(double, double, double, double, double *, double *, double *);
+double getMin(double [], int);
+double getMax(double [], int);
+void plot(DONNEES *, RESULTATS *);
 void lireFichier(DONNEES [], FILE *);
 void ecrireFichier(DONNEES [], FILE *);
+int convertirFichier(const unsigned char [], long, DONNEES []);
 double invitation(char []);
 void demandeSauver(DONNEES *, DONNEES [], FILE *);
+void initOptions(OPTIONS *);
+void demandeOptions(OPTIONS *);
+void menuOptions(OPTIONS *);
+void choixMethode(OPTIONS *);
+int demandeOuiNon(char []);
 
 
 /*---------------------------------------------------------------------
@@ -85,21 +586,59 @@ void main()
     int recommence; //drapeau afin de recommecer le programme
     int ix;
     FILE *fichierPtr;
+    OPTIONS options; //options de calcul choisies par l'utilisateur
+    TABLE_FRICTION table; //table prcalcule du facteur de friction
+    SUBSTITUT substitut; //substitut de Tchebychev du facteur de friction
+    RESULTATS resultats = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0}; //rsultats supplmentaires par point
+    GRILLE_PARAMETRES grille; //grille multidimensionnelle de paramtres
+    CACHE_BALAYAGE cache; //dernier balayage russi, pour le recalcul incrmental
+    MEMO memo; //mmosation persistante du facteur de friction
 
     printf("Bienvenue au projet!\n\n");
+    initOptions(&options); //options par dfaut
+    table.xtbl = NULL; //la table n'est construite que si la mthode est choisie
+    table.projection = NULL;
+    options.tablePtr = &table;
+    substitut.coef = NULL; //le substitut n'est ajust que si la mthode est choisie
+    options.substitutPtr = &substitut;
+    options.resPtr = &resultats;
+    grille.ftbl = NULL; //la grille n'est alloue que si elle est demande
+    for(ix = 0; ix < NBR_AXES; ix = ix + 1)
+        grille.axes[ix].valeurs = NULL;
+    options.grillePtr = &grille;
+    cache.valide = FAUX; //aucun balayage n'est encore calcul
+    cache.dtbl = NULL;
+    cache.ftbl = NULL;
+    options.cachePtr = &cache;
+    memo.cases = NULL; //la mmosation n'est charge que si elle est demande
+    options.memoPtr = &memo;
+    donnees.nbrPoints = 0; //aucun tableau n'est encore allou
+    donnees.dtbl = NULL;
+    donnees.ftbl = NULL;
     do
     {
         for(ix = 0; ix < NBR_SAUVER; ix = ix +1) //affecte estVide  vrai pour chaque membre
             tblSave[ix].estVide = VRAI;
 
         lireFichier(tblSave, fichierPtr); //procure les donnes stockes dans le fichier
-        obtientDonnees(&donnees, tblSave, fichierPtr); //obtient les donnes de l'utilisateur
-        plot(&donnees); //affiche le graphique du facteur de friction
+        demandeOptions(&options); //offre de modifier les options de calcul
+        obtientDonnees(&donnees, tblSave, fichierPtr, &options); //obtient les donnes de l'utilisateur
+        if(memo.cases != NULL && memo.nbrNouveaux > 0 && ecrireMemo(&memo) == FAUX)
+            printf("\nImpossible d'\202crire la m\202mo\213sation dans %s.", FICHIER_MEMO);
+        plot(&donnees, &resultats); //affiche le graphique du facteur de friction
 
         recommence = demandeReboot(); //demande de recommencer le programme
     }
     while(recommence == VRAI);
 
+    libererTableaux(&donnees);
+    libererTable(&table);
+    libererSubstitut(&substitut);
+    libererResultats(&resultats);
+    libererGrille(&grille);
+    libererCache(&cache);
+    libererMemo(&memo);
+    free(options.listetbl);
     printf("\n\nProgramme termin\202! \n\n");
 }
 
@@ -111,21 +650,110 @@ Param
 Valeur de retour :  void
 
 Description : Cette fonction lit les donnes d'un fichier binaire existant et
-l'affecte dans le tableau de sauvegarde.
+l'affecte dans le tableau de sauvegarde. Le fichier contient NBR_SAUVER membres de
+type ENREGISTREMENT; un fichier d'une autre taille est converti par convertirFichier()
+s'il est  un format prcdent, sinon il est ignor et le tableau reste vide. Les
+tableaux du diamtre et du facteur de friction ne sont pas sauvegards : leurs
+pointeurs sont mis  NULL.
 ------------------------------------------------------------------------*/
 void lireFichier(DONNEES tblPtr[], FILE *fPtr)
 {
+    unsigned char octets[NBR_SAUVER*TAILLE_MEMBRE_ORIGINE + 1]; //contenu du fichier, assez pour le plus grand format
+    ENREGISTREMENT membre;
+    long taille; //nombre d'octets lus
+    int ix;
+
+    for(ix = 0; ix < NBR_SAUVER; ix = ix +1) //les tableaux ne sont pas sauvegards
+    {
+        tblPtr[ix].dtbl = NULL;
+        tblPtr[ix].ftbl = NULL;
+    }
+
     fPtr = fopen(FICHIER_BIN, "rb"); //ouvre le fichier
     if(fPtr == NULL) //si le fichier n'existe pas
     {
-        fclose(fPtr);
         ecrireFichier(tblPtr, fPtr); //cre nouveau fichier
+        return;
     }
-    else //lit fichier existant
+    taille = (long)fread(octets, 1, sizeof(octets), fPtr); //lit fichier existant
+    fclose(fPtr);
+
+    if(taille == NBR_SAUVER*(long)sizeof(ENREGISTREMENT))
     {
-        fread(tblPtr, sizeof(DONNEES), NBR_SAUVER, fPtr);
-        fclose(fPtr);
+        for(ix = 0; ix < NBR_SAUVER; ix = ix +1)
+        {
+            memcpy(&membre, &octets[ix*sizeof(ENREGISTREMENT)], sizeof(ENREGISTREMENT));
+            tblPtr[ix].rey = membre.rey;
+            tblPtr[ix].dmax = membre.dmax;
+            tblPtr[ix].dmin = membre.dmin;
+            tblPtr[ix].eps = membre.eps;
+            tblPtr[ix].ro = membre.ro;
+            tblPtr[ix].mu = membre.mu;
+            tblPtr[ix].debit = membre.debit;
+            tblPtr[ix].vit = membre.vit;
+            tblPtr[ix].nbrPoints = membre.nbrPoints;
+            tblPtr[ix].estVide = membre.estVide == FAUX ? FAUX : VRAI;
+        }
+    }
+    else if(convertirFichier(octets, taille, tblPtr) == VRAI)
+    {
+        ecrireFichier(tblPtr, NULL); //rcrit le fichier au format courant
+        printf("Le fichier %s a \202t\202 converti au format courant.\n", FICHIER_BIN);
+    }
+    else
+        printf("Le fichier %s n'est pas reconnu (%ld octets) : il sera remplac\202 \205 la prochaine sauvegarde.\n",
+               FICHIER_BIN, taille);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : convertirFichier
+Paramtres :
+    octets - contenu du fichier FICHIER_BIN
+    taille - nombre d'octets du fichier
+    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
+Valeur de retour :  VRAI si le fichier est  un format prcdent connu, FAUX sinon
+
+Description : Lit les membres d'un fichier crit par une version prcdente, qui copiait
+DONNEES telle quelle : soit le format d'origine (membres de TAILLE_MEMBRE_ORIGINE octets
+avec les tableaux de NBR_POINTS_ORIGINE diamtres en ligne), soit le format  pointeurs
+d'un excutable 64 bits (membres de TAILLE_MEMBRE_POINTEURS octets). Les champs sont pris
+ leur position dans l'ancienne structure. Un membre dont le nombre de diamtres n'est
+pas valide est vid.
+------------------------------------------------------------------------*/
+int convertirFichier(const unsigned char octets[], long taille, DONNEES tblPtr[])
+{
+    const unsigned char *mPtr; //dbut du membre courant
+    long tailleMembre = taille/NBR_SAUVER;
+    int posEps; //position de la rugosit; les champs suivants la suivent comme dans DONNEES
+    int32_t nbrPoints = NBR_POINTS_ORIGINE;
+    int32_t estVide;
+    int ix;
+
+    if(taille == NBR_SAUVER*TAILLE_MEMBRE_ORIGINE)
+        posEps = 3*sizeof(double) + 2*NBR_POINTS_ORIGINE*sizeof(double);
+    else if(taille == NBR_SAUVER*TAILLE_MEMBRE_POINTEURS)
+        posEps = 3*sizeof(double) + sizeof(double) + 2*sizeof(uint64_t); //nbrPoints et son remplissage, dtbl, ftbl
+    else
+        return(FAUX);
+
+    for(ix = 0; ix < NBR_SAUVER; ix = ix +1)
+    {
+        mPtr = &octets[ix*tailleMembre];
+        memcpy(&tblPtr[ix].rey, mPtr, sizeof(double));
+        memcpy(&tblPtr[ix].dmax, mPtr + sizeof(double), sizeof(double));
+        memcpy(&tblPtr[ix].dmin, mPtr + 2*sizeof(double), sizeof(double));
+        if(tailleMembre == TAILLE_MEMBRE_POINTEURS)
+            memcpy(&nbrPoints, mPtr + 3*sizeof(double), sizeof(int32_t));
+        memcpy(&tblPtr[ix].eps, mPtr + posEps, sizeof(double));
+        memcpy(&tblPtr[ix].ro, mPtr + posEps + sizeof(double), sizeof(double));
+        memcpy(&tblPtr[ix].mu, mPtr + posEps + 2*sizeof(double), sizeof(double));
+        memcpy(&tblPtr[ix].debit, mPtr + posEps + 3*sizeof(double), sizeof(double));
+        memcpy(&tblPtr[ix].vit, mPtr + posEps + 4*sizeof(double), sizeof(double));
+        memcpy(&estVide, mPtr + posEps + 5*sizeof(double), sizeof(int32_t));
+        tblPtr[ix].nbrPoints = nbrPoints;
+        tblPtr[ix].estVide = estVide == FAUX && nbrPoints >= NBR_POINTS_MIN && nbrPoints <= NBR_POINTS_MAX ? FAUX : VRAI;
     }
+    return(VRAI);
 }
 
 /*-----------------------------------------------------------------------
@@ -135,12 +763,39 @@ Param
     fPtr - pointeur rfrant  la structure FILE.
 Valeur de retour :  void
 
-Description : crit les valeurs du tableau de sauvegarde dans un fichier binaire.
+Description : crit les valeurs du tableau de sauvegarde dans un fichier binaire, un
+membre de type ENREGISTREMENT par donne (les tableaux ne sont pas sauvegards).
 ------------------------------------------------------------------------*/
 void ecrireFichier(DONNEES tblPtr[], FILE *fPtr)
 {
+    ENREGISTREMENT membres[NBR_SAUVER];
+    int ix;
+
+    memset(membres, 0, sizeof(membres));
+    for(ix = 0; ix < NBR_SAUVER; ix = ix +1)
+    {
+        membres[ix].estVide = tblPtr[ix].estVide == FAUX ? FAUX : VRAI;
+        if(membres[ix].estVide == FAUX)
+        {
+            membres[ix].rey = tblPtr[ix].rey;
+            membres[ix].dmax = tblPtr[ix].dmax;
+            membres[ix].dmin = tblPtr[ix].dmin;
+            membres[ix].eps = tblPtr[ix].eps;
+            membres[ix].ro = tblPtr[ix].ro;
+            membres[ix].mu = tblPtr[ix].mu;
+            membres[ix].debit = tblPtr[ix].debit;
+            membres[ix].vit = tblPtr[ix].vit;
+            membres[ix].nbrPoints = tblPtr[ix].nbrPoints;
+        }
+    }
+
     fPtr = fopen(FICHIER_BIN, "wb");
-    fwrite(tblPtr, sizeof(DONNEES), NBR_SAUVER, fPtr); //crit les donnees dans le fichier
+    if(fPtr == NULL)
+    {
+        printf("\nImpossible d'\202crire dans %s.", FICHIER_BIN);
+        return;
+    }
+    fwrite(membres, sizeof(ENREGISTREMENT), NBR_SAUVER, fPtr); //crit les donnees dans le fichier
     fclose(fPtr);
 }
 
@@ -174,436 +829,4960 @@ int demandeReboot()
 }
 
 /*-----------------------------------------------------------------------
-Fonction : obtientDonnees
+Fonction : initOptions
 Paramtres :
-    dPtr - pointeur rfrant  la structure DONNEES donnees.
-    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
-    fPtr - pointeur rfrant  la structure FILE.
+    optPtr - pointeur rfrant  la structure OPTIONS.
 Valeur de retour :  void
 
-Description : Offre l'option de fournir ses propres donnes ou de choisir des donnes existantes.
+Description : Affecte les valeurs par dfaut aux options de calcul.
 ------------------------------------------------------------------------*/
-void obtientDonnees(DONNEES *dPtr, DONNEES tblPtr[], FILE *fPtr)
+void initOptions(OPTIONS *optPtr)
 {
-    int choix; //choix 1 ou 2 de l'utilisateur
-
-    printf("\nVoulez vous : \n1) fournir vos propres donn\202es, ou\n");
-    printf("2) utiliser des donn\202es d\202ja existantes?\n");
+    optPtr->methode = NEWTON;
+    optPtr->nbrEvaluations = 0;
+    optPtr->continuation = VRAI;
+    optPtr->graine = 0;
+    optPtr->nbrFils = nbrProcesseurs();
+    optPtr->ordonnancement = VOL_TACHES;
+    optPtr->tablePtr = NULL;
+    optPtr->substitutPtr = NULL;
+    optPtr->noyau = NOYAU_AUTO;
+    choisirNoyau(optPtr);
+    optPtr->precision = PRECISION_DOUBLE;
+    initCritere(&optPtr->critere);
+    optPtr->suivi = FAUX;
+    optPtr->sensibilites = FAUX;
+    optPtr->echantillonnage = UNIFORME;
+    optPtr->tolEchantillon = TOLERANCE_ECHANTILLON;
+    optPtr->grille = GRILLE_LINEAIRE;
+    optPtr->raison = 1;
+    optPtr->listetbl = NULL;
+    optPtr->nbrListe = 0;
+    optPtr->reyVariable = VRAI;
+    optPtr->flux = SANS_FLUX;
+    optPtr->grillePtr = NULL;
+    optPtr->resPtr = NULL;
+    optPtr->cachePtr = NULL;
+    optPtr->anciennetbl = NULL;
+    optPtr->memoisation = FAUX;
+    optPtr->memoPtr = NULL;
+}
 
-    do
-    {
-        printf("Entrez 1 ou 2 : ");
-        fflush(stdin);
-        scanf("%d", &choix);
-    }
-    while(choix != 1 && choix != 2);
+/*-----------------------------------------------------------------------
+Fonction : demandeOptions
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS.
+Valeur de retour :  void
 
-    if(choix == 1)
-        entrerDonnees(dPtr, tblPtr, fPtr);
-    else if(choix == 2)
-        choixDonnees(tblPtr, dPtr, fPtr);
+Description : Cette fonction demande  l'utilisateur s'il veut modifier les options
+de calcul. Si oui, fait appel  menuOptions.
+------------------------------------------------------------------------*/
+void demandeOptions(OPTIONS *optPtr)
+{
+    if(demandeOuiNon("Voulez-vous modifier les options de calcul?") == VRAI)
+        menuOptions(optPtr);
 }
 
 /*-----------------------------------------------------------------------
-Fonction : choixDonnees
+Fonction : menuOptions
 Paramtres :
-    dPtr - pointeur rfrant  la structure DONNEES donnees.
-    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
-    fPtr - pointeur rfrant  la structure FILE.
+    optPtr - pointeur rfrant  la structure OPTIONS.
 Valeur de retour :  void
 
-Description : Affiche le contenu du fichier (tableau de sauvegarde) et demande 
-l'utilisateur quelles donnes  choisir.
+Description : Affiche les options de calcul avec leurs valeurs courantes et
+permet  l'utilisateur de les modifier une  la fois, jusqu' ce qu'il entre 0.
 ------------------------------------------------------------------------*/
-void choixDonnees(DONNEES tblPtr[], DONNEES *dPtr, FILE *fPtr)
+void menuOptions(OPTIONS *optPtr)
 {
     int choix; //choix de l'utilisateur
-    if(tblPtr[0].estVide == VRAI)
-    {
-        printf("\nTout est vide. Vous devez entrer vos propres donn\202es.");
-        entrerDonnees(dPtr, tblPtr, fPtr);
-    }
-    else
+
+    do
     {
-        afficheDonnees(tblPtr);
-        printf("\nVeuillez s\202lectionner un ensemble de donn\202es (1 \205 5) : ");
+        printf("\nOptions de calcul : \n");
+        printf("1) M\202thode de r\202solution : %s\n", nomMethode(optPtr->methode));
+        printf("2) Continuation d'un diam\212tre au suivant : %s\n", optPtr->continuation == VRAI ? "oui" : "non");
+        printf("3) Nombre de fils d'ex\202cution : %d\n", optPtr->nbrFils);
+        printf("4) Partage du travail entre les fils : %s\n", optPtr->ordonnancement == VOL_TACHES ? "vol de t\203ches" : "statique");
+        printf("5) Noyau de Newton : %s%s\n", nomNoyau(optPtr->noyauChoisi), optPtr->noyau == NOYAU_AUTO ? " (choisi automatiquement)" : "");
+        printf("6) Pr\202cision de Newton : %s\n", nomPrecision(optPtr->precision));
+        printf("7) Crit\212re d'arr\210t : |erreur sur f| <= %g + %g*f, au plus %d it\202rations par point\n",
+               optPtr->critere.tolAbs, optPtr->critere.tolRel, optPtr->critere.iterMax);
+        printf("8) Suivi des \202valuations et du r\202sidu de chaque point : %s\n", optPtr->suivi == VRAI ? "oui" : "non");
+        printf("9) Sensibilit\202s df/dd, df/drey et df/deps de chaque point : %s\n", optPtr->sensibilites == VRAI ? "oui" : "non");
+        if(optPtr->echantillonnage == ADAPTATIF)
+            printf("10) \220chantillonnage des diam\212tres : adaptatif, erreur d'interpolation relative %g\n", optPtr->tolEchantillon);
+        else
+            printf("10) \220chantillonnage des diam\212tres : uniforme\n");
+        printf("11) Grille des diam\212tres : %s\n", nomGrille(optPtr->grille));
+        printf("12) Nombre de Reynolds et vitesse : %s\n", optPtr->reyVariable == VRAI ? "calcul\202s \205 chaque diam\212tre" : "calcul\202s une fois, au diam\212tre maximal");
+        printf("13) Sortie du balayage : %s\n", nomFlux(optPtr->flux));
+        if(optPtr->memoisation == VRAI)
+            printf("14) M\202mo\213sation persistante (%s) : oui, %ld facteurs de friction connus\n", FICHIER_MEMO, optPtr->memoPtr->nbrEntrees);
+        else
+            printf("14) M\202mo\213sation persistante (%s) : non\n", FICHIER_MEMO);
+        printf("0) Terminer\n");
 
-        do //s'assure que le choix n'est pas vide
+        do
         {
-            do //s'assure que l'entre est valide
+            printf("Entrez un chiffre de 0 \205 14 : ");
+            fflush(stdin);
+            scanf("%d", &choix);
+        }
+        while(choix < 0 || choix > 14);
+
+        if(choix == 1)
+            choixMethode(optPtr);
+        else if(choix == 2)
+            optPtr->continuation = demandeOuiNon("Chaque diam\212tre doit-il partir de la solution du diam\212tre pr\202c\202dent?");
+        else if(choix == 3)
+        {
+            do
+                optPtr->nbrFils = (int)invitation("le nombre de fils d'ex\202cution (1 = s\202quentiel)");
+            while(optPtr->nbrFils < 1 || optPtr->nbrFils > NBR_FILS_MAX);
+        }
+        else if(choix == 4)
+        {
+            if(demandeOuiNon("Les fils doivent-ils se voler des t\203ches (sinon partage statique)?") == VRAI)
+                optPtr->ordonnancement = VOL_TACHES;
+            else
+                optPtr->ordonnancement = STATIQUE;
+        }
+        else if(choix == 5)
+            choixNoyau(optPtr);
+        else if(choix == 6)
+        {
+            printf("\n%d) %s\n%d) %s\n%d) %s\n", PRECISION_DOUBLE, nomPrecision(PRECISION_DOUBLE), PRECISION_SIMPLE,
+                   nomPrecision(PRECISION_SIMPLE), PRECISION_RAFFINEE, nomPrecision(PRECISION_RAFFINEE));
+            do
             {
+                printf("Entrez un chiffre de %d \205 %d : ", PRECISION_DOUBLE, PRECISION_RAFFINEE);
                 fflush(stdin);
-                scanf("%d", &choix);
-
-                if(choix < 1 || choix > 5)
-                    printf("Entrez un chiffre de 1 \205 5 : ");
+                scanf("%d", &optPtr->precision);
             }
-            while( choix < 1 || choix > 5);  //choix invalide
-
-            if(tblPtr[choix - 1].estVide == VRAI) //si le choix est vide
-                printf("La s\202lection ne contient pas de donn\202es!\n");
+            while(optPtr->precision < PRECISION_DOUBLE || optPtr->precision > PRECISION_RAFFINEE);
         }
-        while(tblPtr[choix - 1].estVide == VRAI);  //choix est vide
+        else if(choix == 7)
+        {
+            choixCritere(&optPtr->critere);
+            if(optPtr->memoisation == VRAI && !memeCritere(&optPtr->memoPtr->critere, &optPtr->critere))
+                chargerMemo(optPtr->memoPtr, &optPtr->critere); //les entres ne valent que pour l'ancien critre
+        }
+        else if(choix == 8)
+            optPtr->suivi = demandeOuiNon("Conserver le nombre d'\202valuations et le r\202sidu de chaque point (calcul scalaire)?");
+        else if(choix == 9)
+            optPtr->sensibilites = demandeOuiNon("Calculer les sensibilit\202s du facteur de friction dans le m\210me balayage?");
+        else if(choix == 10)
+        {
+            if(demandeOuiNon("R\202partir les diam\212tres selon la courbure (le nombre de diam\212tres devient un maximum)?") == VRAI)
+            {
+                optPtr->echantillonnage = ADAPTATIF;
+                optPtr->tolEchantillon = invitation("l'erreur relative d'interpolation vis\202e");
+            }
+            else
+                optPtr->echantillonnage = UNIFORME;
+        }
+        else if(choix == 11)
+            choixGrille(optPtr);
+        else if(choix == 12)
+            optPtr->reyVariable = demandeOuiNon("Calculer le nombre de Reynolds et la vitesse \205 chaque diam\212tre?");
+        else if(choix == 13)
+            choixFlux(optPtr);
+        else if(choix == 14)
+            choixMemo(optPtr);
+    }
+    while(choix != 0);
+}
 
-        *dPtr = tblPtr[choix - 1];
-        printf("\nLes donn\202es ont \202t\202 import\202es.\n");
+/*-----------------------------------------------------------------------
+Fonction : demandeOuiNon
+Paramtres :
+    question - chane de caractres de la question  poser
+Valeur de retour :  VRAI si l'utilisateur rpond 'o', FAUX s'il rpond 'n'
+
+Description : Pose une question  laquelle on rpond par 'o' ou 'n' et rpte
+la demande tant que la rponse n'est pas valide.
+------------------------------------------------------------------------*/
+int demandeOuiNon(char question[])
+{
+    char reponse; //rponse de l'utilisateur
+    printf("\n%s (o/n) : ", question);
+    fflush(stdin);
+    scanf("%c", &reponse);
+    while(reponse != 'o' && reponse != 'n')//s'assure que l'utilisateur entre un caractre valide
+    {
+        printf(" - ERREUR! Le caract\212re n'est pas valide. S.V.P r\202pondre 'o' ou 'n' : ");
+        fflush(stdin);
+        scanf("%c", &reponse);
     }
+    if(reponse == 'o')
+        return(VRAI);
+    else
+        return(FAUX);
 }
 
 /*-----------------------------------------------------------------------
-Fonction : afficheDonnees
+Fonction : choixGrille
 Paramtres :
-    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
+    optPtr - pointeur rfrant  la structure OPTIONS.
 Valeur de retour :  void
 
-Description : Affiche les donnes dans le tableau de sauvegarde.
+Description : Demande  l'utilisateur la grille des diamtres. La grille gomtrique
+demande la raison (plus grande que 1) et la liste demande chaque diamtre; la liste est
+trie en ordre croissant et ses diamtres doivent tre distincts.
 ------------------------------------------------------------------------*/
-void afficheDonnees(DONNEES tblPtr[])
+void choixGrille(OPTIONS *optPtr)
 {
-    int ix; //index de la structure  afficher
+    int choix; //choix de l'utilisateur
+    int ix;
+    int nbr; //nombre de diamtres de la liste
+    int distincts; //drapeau : les diamtres de la liste sont distincts
+    double *listetbl; //nouvelle liste
+    char texte[64]; //invitation pour chaque diamtre
 
-    for(ix = 0; ix < NBR_SAUVER; ix = ix +1)
+    printf("\nGrille des diam\212tres : \n");
+    for(ix = GRILLE_LINEAIRE; ix <= GRILLE_LISTE; ix = ix + 1)
+        printf("%d) %s\n", ix, nomGrille(ix));
+    do
     {
-        printf("\n %d) \n\n", ix+1);
+        printf("Entrez un chiffre de %d \205 %d : ", GRILLE_LINEAIRE, GRILLE_LISTE);
+        fflush(stdin);
+        scanf("%d", &choix);
+    }
+    while(choix < GRILLE_LINEAIRE || choix > GRILLE_LISTE);
 
-        if(tblPtr[ix].estVide == VRAI) //si membre est vide
-            printf("%20cVIDE\n", ' ');
-        else if(tblPtr[ix].estVide == FAUX) //si membre contient des donnes
+    if(choix == GRILLE_GEOMETRIQUE)
+    {
+        do
+            optPtr->raison = invitation("la raison entre deux diam\212tres successifs (plus grande que 1)");
+        while(optPtr->raison <= 1);
+    }
+    else if(choix == GRILLE_LISTE)
+    {
+        nbr = demandeNbrPoints();
+        listetbl = reallouerTableau(NULL, nbr, sizeof(double));
+        if(listetbl == NULL)
         {
-            printf("%5cDiam\212tre minimal (m)  : %.3g \n", ' ', tblPtr[ix].dmin);
-            printf("%5cDiam\212tre maximal (m)  : %g \n", ' ', tblPtr[ix].dmax);
-            printf("%5cRugosit\202 (m)          : %g \n", ' ', tblPtr[ix].eps);
-            printf("%5cDensit\202 (kg/m^3)      : %g \n", ' ', tblPtr[ix].ro);
-            printf("%5cViscosit\202 (N*s/m^2)   : %g \n", ' ', tblPtr[ix].mu);
-            printf("%5cD\202bit de flux (m^3/s) : %g \n\n", ' ', tblPtr[ix].debit);
-            printf("%5cNombre de Reynolds calcul\202       : %.3f \n", ' ', tblPtr[ix].rey);
-            printf("%5cVitesse du fluide calcul\202e (m/s) : %.3f \n", ' ', tblPtr[ix].vit);
+            printf("\n - ERREUR! M\202moire insuffisante pour %d diam\212tres.\n", nbr);
+            return;
         }
-        printf("-----------------------------------------------\n");
+        do
+        {
+            for(ix = 0; ix < nbr; ix = ix + 1)
+            {
+                sprintf(texte, "le diam\212tre %d en m", ix + 1);
+                listetbl[ix] = invitation(texte);
+            }
+            qsort(listetbl, nbr, sizeof(double), comparerCroissant);
+            distincts = VRAI;
+            for(ix = 1; ix < nbr; ix = ix + 1)
+                if(listetbl[ix] == listetbl[ix-1] || listetbl[ix-1] <= 0)
+                    distincts = FAUX;
+            if(distincts == FAUX)
+                printf(" - ERREUR! Les diam\212tres doivent \210tre positifs et distincts.\n");
+        }
+        while(distincts == FAUX);
+        free(optPtr->listetbl);
+        optPtr->listetbl = listetbl;
+        optPtr->nbrListe = nbr;
     }
+    optPtr->grille = choix;
 }
 
-/*------------
-Fonction :  entrerDonnees
+/*-----------------------------------------------------------------------
+Fonction : nomGrille
+Paramtres :
+    grille - numro de la grille des diamtres
+Valeur de retour :  nom - chane de caractres qui dcrit la grille
 
-Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
-                tblPtr - pointeur rfrant le tableau de type DONNEES
-                fPtr - pointeur rfrant  la structure FILE
+Description : Retourne le nom de la grille des diamtres, pour l'affichage.
+------------------------------------------------------------------------*/
+char *nomGrille(int grille)
+{
+    char *nom;
 
+    if(grille == GRILLE_LOG)
+        nom = "logarithmique (m\210me nombre de diam\212tres par d\202cade)";
+    else if(grille == GRILLE_GEOMETRIQUE)
+        nom = "g\202om\202trique (raison fixe)";
+    else if(grille == GRILLE_LISTE)
+        nom = "liste de diam\212tres";
+    else
+        nom = "lin\202aire (pas constant)";
+    return(nom);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixMethode
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS.
 Valeur de retour :  void
 
-Description :   Cette fonction demande les entres de lutilisateur  l'aide de invitation().
-Pour les entres de dmax et dmin, vrifie si les valeurs sont acceptables en faisant appel 
-la fonction verifieDiam(). Pour la viscosit, la densit, la rugosit et le dbit, la
-fonction doit vrifier si ces valeurs sont plus grandes que 0 en faisant appel  la fonction
-getValeurPositive(). Pour le nombre de Reynolds, on calcule sa valeur en appelant la fonction
-calculerRey(). Ensuite, fait appel  demandeSauver() pour offrir de sauvgarder les donnes.
-------------*/
-void entrerDonnees(DONNEES *dPtr, DONNEES *tblPtr, FILE *fPtr)
+Description : Demande  l'utilisateur la mthode de rsolution de l'quation Colebrook.
+Si la table prcalcule ou le substitut de Tchebychev est choisi, fait appel 
+choixTable ou  choixSubstitut pour le prparer.
+------------------------------------------------------------------------*/
+void choixMethode(OPTIONS *optPtr)
 {
-    do
-    {
+    int choix; //choix de l'utilisateur
+    int ix;
+
+    printf("\nM\202thode de r\202solution de l'\202quation Colebrook : \n");
+    for(ix = BISSECTION; ix <= CHEBYSHEV; ix = ix + 1)
+    {
+        printf("%d) %s", ix, nomMethode(ix));
+        if(ix == OMEGA_WRIGHT)
+            printf(" (explicite, exacte)");
+        else if(ix == TABLE_BICUBIQUE || ix == CHEBYSHEV)
+            printf(" (interpolation, approximative)");
+        else if(ix >= HAALAND)
+            printf(" (explicite, approximative)");
+        printf("\n");
+    }
+
+    do
+    {
+        printf("Entrez un chiffre de %d \205 %d : ", BISSECTION, CHEBYSHEV);
+        fflush(stdin);
+        scanf("%d", &choix);
+    }
+    while(choix < BISSECTION || choix > CHEBYSHEV);
+
+    optPtr->methode = choix;
+    if(choix == TABLE_BICUBIQUE)
+    {
+        choixTable(optPtr->tablePtr);
+        if(optPtr->tablePtr->xtbl == NULL) //mmoire insuffisante, garde Newton
+            optPtr->methode = NEWTON;
+    }
+    else if(choix == CHEBYSHEV)
+    {
+        choixSubstitut(optPtr->substitutPtr);
+        if(optPtr->substitutPtr->coef == NULL) //ajustement impossible, garde Newton
+            optPtr->methode = NEWTON;
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : obtientDonnees
+Paramtres :
+    dPtr - pointeur rfrant  la structure DONNEES donnees.
+    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
+    fPtr - pointeur rfrant  la structure FILE.
+    optPtr - pointeur rfrant  la structure OPTIONS.
+Valeur de retour :  void
+
+Description : Offre l'option de fournir ses propres donnes ou de choisir des donnes existantes.
+Si le balayage des diamtres choue, l'erreur rendue par remplirTableaux() est affiche par
+afficheErreurBalayage() et le choix est offert de nouveau, dans une boucle plutt que par un
+appel rcursif.
+------------------------------------------------------------------------*/
+void obtientDonnees(DONNEES *dPtr, DONNEES tblPtr[], FILE *fPtr, OPTIONS *optPtr)
+{
+    int choix; //choix 1 ou 2 de l'utilisateur
+    int code; //rsultat du balayage (STATUT_OK si russi)
+    ERREUR_BALAYAGE erreur; //dtail de l'chec du balayage
+
+    do
+    {
+        printf("\nVoulez vous : \n1) fournir vos propres donn\202es,\n");
+        printf("2) utiliser des donn\202es d\202ja existantes, ou\n");
+        printf("3) calculer une grille de plusieurs param\212tres (diam\212tre, rugosit\202, densit\202, viscosit\202, d\202bit)?\n");
+
         do
         {
-            //demande des valeurs des diamtres et vrification de ces valeurs
-            dPtr->dmax = invitation("le diam\212tre maximal en m");
-            dPtr->dmin = invitation("le diam\212tre minimal en m");
+            printf("Entrez 1, 2 ou 3 : ");
+            fflush(stdin);
+            scanf("%d", &choix);
         }
-        while(!verifieDiam(dPtr));
+        while(choix < 1 || choix > 3);
 
-        //demande pour la valeur de la rugosit et vrification de cette valeur
-        dPtr->eps = invitation("la rugosit\202 du conduit en m");
-        //demande pour la valeur de la densit et vrification de cette valeur
-        dPtr->ro = invitation("la densit\202 du fluide en kg/m^3");
-        //demande pour la valeur de la viscosit et vrification de cette valeur
-        dPtr->mu = invitation("la viscosit\202 du fluide en N*s/m^2");
-        //demande pour la valeur du dbit et vrification de cette valeur
-        dPtr->debit = invitation("le d\202bit de flux du fluide en m^3/s");
+        code = STATUT_OK;
+        if(choix == 1)
+            code = entrerDonnees(dPtr, tblPtr, fPtr, optPtr, &erreur);
+        else if(choix == 2)
+            code = choixDonnees(tblPtr, dPtr, fPtr, optPtr, &erreur);
+        else
+            code = entrerGrille(dPtr, optPtr, &erreur);
+
+        if(code != STATUT_OK)
+            afficheErreurBalayage(&erreur);
     }
-    while(!calculerRey(dPtr)); //vrifie que # de Reynolds > 4000
-    printf("Test r\202ussi : le nombre de Reynolds obtenu est %f.", dPtr->rey);
+    while(code != STATUT_OK);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : entrerGrille
+Paramtres :
+    dPtr - pointeur rfrant  la structure DONNEES
+    optPtr - pointeur rfrant  la structure OPTIONS
+    errPtr - pointeur o crire l'erreur
+Valeur de retour :  STATUT_OK, ou STATUT_MEMOIRE si la coupe ne peut pas tre alloue
+
+Description : Demande l'tendue de chaque paramtre de la grille multidimensionnelle
+(voir demandeAxe()), calcule la grille avec calculerGrille() et affiche son rsum. Pour
+le graphique, dPtr reoit la coupe selon le diamtre au point de la grille o f est
+maximal (voir extraireCoupe()). Si la grille est trop grande pour la mmoire ou pour
+POINTS_GRILLE_MAX, les tendues sont redemandes; si la coupe ne peut pas tre alloue,
+l'erreur est rendue  obtientDonnees(), qui redemande les donnes.
+------------------------------------------------------------------------*/
+int entrerGrille(DONNEES *dPtr, OPTIONS *optPtr, ERREUR_BALAYAGE *errPtr)
+{
+    GRILLE_PARAMETRES *gPtr = optPtr->grillePtr;
+    double debut; //temps au dbut du calcul
+    double nbrPoints; //nombre de points demands
+    int ix;
+    int ok; //drapeau : la grille est alloue
+
+    do
+    {
+        nbrPoints = 1;
+        for(ix = 0; ix < NBR_AXES; ix = ix + 1)
+        {
+            demandeAxe(&gPtr->axes[ix], ix);
+            nbrPoints = nbrPoints*gPtr->axes[ix].nbr;
+        }
+        ok = FAUX;
+        if(nbrPoints > POINTS_GRILLE_MAX)
+            printf("\n - ERREUR! La grille compte %.0f points, plus que le maximum de %.0f.\n", nbrPoints, POINTS_GRILLE_MAX);
+        else
+            ok = allouerGrille(gPtr);
+    }
+    while(ok == FAUX);
+
+    if(optPtr->memoisation == VRAI) //les compteurs ne portent que sur cette grille
+    {
+        optPtr->memoPtr->nbrTrouves = 0;
+        optPtr->memoPtr->nbrManques = 0;
+    }
+    debut = chrono();
+    calculerGrille(gPtr, optPtr);
+    afficheGrille(gPtr, chrono() - debut);
+    if(optPtr->memoisation == VRAI)
+        afficheMemo(optPtr->memoPtr);
+
+    optPtr->resPtr->nbrTraces = 0; //le graphique vient de la coupe, pas d'un balayage en flux
+    errPtr->code = STATUT_OK;
+    errPtr->d = 0;
+    if(extraireCoupe(gPtr, dPtr) == FAUX)
+        errPtr->code = STATUT_MEMOIRE;
+    return(errPtr->code);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : demandeAxe
+Paramtres :
+    axePtr - pointeur rfrant  l'axe  remplir
+    axe - numro de l'axe (AXE_DEBIT ... AXE_DIAMETRE)
+Valeur de retour :  void
+
+Description : Demande le nombre de valeurs d'un paramtre, puis sa valeur fixe (une seule
+valeur) ou son tendue et son espacement. Le diamtre doit avoir au moins NBR_POINTS_MIN
+valeurs, pour le graphique de la coupe.
+------------------------------------------------------------------------*/
+void demandeAxe(AXE *axePtr, int axe)
+{
+    char texte[128]; //invitation
+    double min, max;
+    int nbr;
+    int espacement = GRILLE_LINEAIRE;
+
+    printf("\n%s :", nomAxe(axe));
+    do
+    {
+        sprintf(texte, "le nombre de valeurs du param\212tre %s (1 pour une valeur fixe)", nomAxe(axe));
+        nbr = (int)invitation(texte);
+    }
+    while(nbr < 1 || (axe == AXE_DIAMETRE && nbr < NBR_POINTS_MIN));
+
+    if(nbr == 1)
+    {
+        sprintf(texte, "%s en %s", nomAxe(axe), uniteAxe(axe));
+        min = invitation(texte);
+        max = min;
+    }
+    else
+    {
+        do
+        {
+            sprintf(texte, "le maximum du param\212tre %s en %s", nomAxe(axe), uniteAxe(axe));
+            max = invitation(texte);
+            sprintf(texte, "le minimum du param\212tre %s en %s", nomAxe(axe), uniteAxe(axe));
+            min = invitation(texte);
+        }
+        while(max <= min || min <= 0);
+        if(demandeOuiNon("Espacer les valeurs selon une \202chelle logarithmique?") == VRAI)
+            espacement = GRILLE_LOG;
+    }
+
+    if(initAxe(axePtr, min, max, nbr, espacement) == FAUX)
+        printf("\n - ERREUR! M\202moire insuffisante pour %d valeurs.\n", nbr);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : initAxe
+Paramtres :
+    axePtr - pointeur rfrant  l'axe
+    min, max - tendue de l'axe
+    nbr - nombre de valeurs
+    espacement - GRILLE_LINEAIRE ou GRILLE_LOG
+Valeur de retour :  VRAI si les valeurs sont alloues, FAUX sinon
+
+Description : Remplit les mtadonnes de l'axe et calcule ses valeurs,  pas constant
+(ou  pas constant en log) de min  max. Les extrmits valent exactement min et max.
+------------------------------------------------------------------------*/
+int initAxe(AXE *axePtr, double min, double max, int nbr, int espacement)
+{
+    int ix;
+    double *valeurs = reallouerTableau(axePtr->valeurs, nbr, sizeof(double));
+
+    if(valeurs == NULL)
+    {
+        axePtr->nbr = 0;
+        return(FAUX);
+    }
+    axePtr->valeurs = valeurs;
+    axePtr->min = min;
+    axePtr->max = max;
+    axePtr->nbr = nbr;
+    axePtr->espacement = espacement;
+
+    valeurs[0] = min;
+    for(ix = 1; ix < nbr - 1; ix = ix + 1)
+    {
+        if(espacement == GRILLE_LOG)
+            valeurs[ix] = min*exp(log(max/min)*ix/(nbr - 1));
+        else
+            valeurs[ix] = min + (max - min)*ix/(nbr - 1);
+    }
+    valeurs[nbr - 1] = max;
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : allouerGrille
+Paramtres :
+    gPtr - pointeur rfrant  la grille, dont les axes sont remplis
+Valeur de retour :  VRAI si la grille est alloue, FAUX si la mmoire manque
+
+Description : Calcule le nombre de points et le pas de chaque axe dans l'indice linaire
+(le dernier axe, AXE_DIAMETRE, a un pas de 1), puis alloue le tableau dense des
+facteurs de friction.
+------------------------------------------------------------------------*/
+int allouerGrille(GRILLE_PARAMETRES *gPtr)
+{
+    int ix;
+    double *ftbl;
+
+    gPtr->nbrPoints = 1;
+    for(ix = NBR_AXES - 1; ix >= 0; ix = ix - 1)
+    {
+        if(gPtr->axes[ix].nbr < 1) //axe non allou
+            return(FAUX);
+        gPtr->pas[ix] = gPtr->nbrPoints;
+        gPtr->nbrPoints = gPtr->nbrPoints*gPtr->axes[ix].nbr;
+    }
+
+    ftbl = reallouerTableau(gPtr->ftbl, gPtr->nbrPoints, sizeof(double));
+    if(ftbl == NULL)
+    {
+        printf("\n - ERREUR! M\202moire insuffisante pour une grille de %.0f points (%.1f Mo).\n",
+               (double)gPtr->nbrPoints, gPtr->nbrPoints*(double)sizeof(double)/1E6);
+        return(FAUX);
+    }
+    gPtr->ftbl = ftbl;
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculerGrille
+Paramtres :
+    gPtr - pointeur rfrant  la grille alloue
+    optPtr - pointeur rfrant  la structure OPTIONS (mthode, noyau, fils d'excution)
+Valeur de retour :  nombre de points dont le facteur de friction a t calcul
+
+Description : Calcule le facteur de friction en chaque point du produit cartsien des
+axes. L'indice linaire est dcoup en blocs de TAILLE_BLOC_GRILLE points contigus; les
+fils d'excution prennent le prochain bloc libre dans un compteur partag (voir
+travailleurGrille()), de sorte que les entres d'un bloc restent dans le cache et que
+chaque fil crit une partie contigu de gPtr->ftbl. Le nombre de Reynolds de chaque point
+est 4*ro*debit/(pi*mu*d). Les statuts, les extrmes et le nombre d'valuations sont
+laisss dans la grille.
+------------------------------------------------------------------------*/
+int64_t calculerGrille(GRILLE_PARAMETRES *gPtr, OPTIONS *optPtr)
+{
+    pthread_t fils[NBR_FILS_MAX]; //fils d'excution
+    TRAVAIL_GRILLE travail[NBR_FILS_MAX]; //travail de chaque fil
+    pthread_mutex_t verrou; //protge prochain
+    int64_t prochain = 0; //prochain bloc  calculer
+    int64_t nbrBlocs = (gPtr->nbrPoints + TAILLE_BLOC_GRILLE - 1)/TAILLE_BLOC_GRILLE;
+    int nbrFils = optPtr->nbrFils;
+    int ix, jx;
+
+    if(nbrFils > nbrBlocs)
+        nbrFils = (int)nbrBlocs;
+
+    pthread_mutex_init(&verrou, NULL);
+    for(ix = 0; ix < nbrFils; ix = ix + 1)
+    {
+        travail[ix].gPtr = gPtr;
+        travail[ix].options = *optPtr;
+        travail[ix].verrouPtr = &verrou;
+        travail[ix].prochainPtr = &prochain;
+        travail[ix].nbrBlocs = nbrBlocs;
+    }
+
+    //le fil principal travaille aussi pendant que les autres calculent
+    for(ix = 1; ix < nbrFils; ix = ix + 1)
+        pthread_create(&fils[ix], NULL, travailleurGrille, &travail[ix]);
+    travailleurGrille(&travail[0]);
+    for(ix = 1; ix < nbrFils; ix = ix + 1)
+        pthread_join(fils[ix], NULL);
+    pthread_mutex_destroy(&verrou);
+
+    //runit les rsultats des fils
+    gPtr->iMin = -1;
+    gPtr->iMax = -1;
+    gPtr->nbrEval = 0;
+    for(jx = 0; jx < 4; jx = jx + 1)
+        gPtr->nbrStatut[jx] = 0;
+    for(ix = 0; ix < nbrFils; ix = ix + 1)
+    {
+        for(jx = 0; jx < 4; jx = jx + 1)
+            gPtr->nbrStatut[jx] = gPtr->nbrStatut[jx] + travail[ix].nbrStatut[jx];
+        gPtr->nbrEval = gPtr->nbrEval + travail[ix].totalEval;
+        if(travail[ix].iMin >= 0 && (gPtr->iMin < 0 || gPtr->ftbl[travail[ix].iMin] < gPtr->ftbl[gPtr->iMin]))
+            gPtr->iMin = travail[ix].iMin;
+        if(travail[ix].iMax >= 0 && (gPtr->iMax < 0 || gPtr->ftbl[travail[ix].iMax] > gPtr->ftbl[gPtr->iMax]))
+            gPtr->iMax = travail[ix].iMax;
+    }
+
+    return(gPtr->nbrStatut[STATUT_OK]);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : travailleurGrille
+Paramtres :
+    arg - pointeur vers la structure TRAVAIL_GRILLE du fil
+Valeur de retour :  NULL
+
+Description : Fonction excute par chaque fil pour la grille. Tant qu'il reste des blocs,
+prend le prochain, trouve les coordonnes de son premier point avec coordonneesGrille(),
+puis avance les coordonnes comme un compteur kilomtrique (le diamtre d'abord) pour
+remplir les nombres de Reynolds et les rugosits relatives du bloc. Le bloc est rsolu
+par calculFrictionLot(), qui crit directement dans la grille.
+------------------------------------------------------------------------*/
+void *travailleurGrille(void *arg)
+{
+    TRAVAIL_GRILLE *tPtr = arg;
+    GRILLE_PARAMETRES *gPtr = tPtr->gPtr;
+    double rey[TAILLE_BLOC_GRILLE], rugRel[TAILLE_BLOC_GRILLE]; //entres du bloc
+    int statut[TAILLE_BLOC_GRILLE]; //statuts du bloc
+    int coord[NBR_AXES]; //coordonnes du point courant
+    double facteur; //4*ro*debit/(pi*mu) pour les coordonnes courantes hors diamtre
+    double d; //diamtre du point courant
+    int64_t bloc; //bloc courant
+    int64_t debut; //premier point du bloc
+    long nbr; //nombre de points du bloc, au plus TAILLE_BLOC_GRILLE
+    long ix;
+    int axe;
+
+    for(axe = 0; axe < 4; axe = axe + 1)
+        tPtr->nbrStatut[axe] = 0;
+    tPtr->iMin = -1;
+    tPtr->iMax = -1;
+    tPtr->totalEval = 0;
+
+    do
+    {
+        pthread_mutex_lock(tPtr->verrouPtr);
+        bloc = *tPtr->prochainPtr;
+        *tPtr->prochainPtr = bloc + 1;
+        pthread_mutex_unlock(tPtr->verrouPtr);
+
+        if(bloc < tPtr->nbrBlocs)
+        {
+            debut = bloc*TAILLE_BLOC_GRILLE;
+            nbr = TAILLE_BLOC_GRILLE;
+            if(gPtr->nbrPoints - debut < TAILLE_BLOC_GRILLE)
+                nbr = (long)(gPtr->nbrPoints - debut);
+
+            coordonneesGrille(gPtr, debut, coord);
+            facteur = 4*gPtr->axes[AXE_DENSITE].valeurs[coord[AXE_DENSITE]]*gPtr->axes[AXE_DEBIT].valeurs[coord[AXE_DEBIT]]
+                      /(M_PI*gPtr->axes[AXE_VISCOSITE].valeurs[coord[AXE_VISCOSITE]]);
+            for(ix = 0; ix < nbr; ix = ix + 1)
+            {
+                d = gPtr->axes[AXE_DIAMETRE].valeurs[coord[AXE_DIAMETRE]];
+                rey[ix] = facteur/d;
+                rugRel[ix] = gPtr->axes[AXE_RUGOSITE].valeurs[coord[AXE_RUGOSITE]]/d;
+
+                //avance au point suivant : le diamtre d'abord, puis les axes plus lents
+                axe = NBR_AXES - 1;
+                coord[axe] = coord[axe] + 1;
+                while(axe > 0 && coord[axe] == gPtr->axes[axe].nbr)
+                {
+                    coord[axe] = 0;
+                    axe = axe - 1;
+                    coord[axe] = coord[axe] + 1;
+                }
+                if(axe < AXE_RUGOSITE) //densit, viscosit ou dbit a chang
+                    facteur = 4*gPtr->axes[AXE_DENSITE].valeurs[coord[AXE_DENSITE] % gPtr->axes[AXE_DENSITE].nbr]
+                              *gPtr->axes[AXE_DEBIT].valeurs[coord[AXE_DEBIT] % gPtr->axes[AXE_DEBIT].nbr]
+                              /(M_PI*gPtr->axes[AXE_VISCOSITE].valeurs[coord[AXE_VISCOSITE] % gPtr->axes[AXE_VISCOSITE].nbr]);
+            }
+
+            calculFrictionLot(rey, rugRel, &gPtr->ftbl[debut], statut, nbr, &tPtr->options);
+            tPtr->totalEval = tPtr->totalEval + tPtr->options.nbrEvaluations;
+
+            for(ix = 0; ix < nbr; ix = ix + 1)
+            {
+                tPtr->nbrStatut[statut[ix]] = tPtr->nbrStatut[statut[ix]] + 1;
+                if(statut[ix] == STATUT_OK)
+                {
+                    if(tPtr->iMin < 0 || gPtr->ftbl[debut+ix] < gPtr->ftbl[tPtr->iMin])
+                        tPtr->iMin = debut + ix;
+                    if(tPtr->iMax < 0 || gPtr->ftbl[debut+ix] > gPtr->ftbl[tPtr->iMax])
+                        tPtr->iMax = debut + ix;
+                }
+            }
+        }
+    }
+    while(bloc < tPtr->nbrBlocs);
+
+    return(NULL);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : indiceGrille
+Paramtres :
+    gPtr - pointeur rfrant  la grille
+    coord - coordonnes du point, une par axe
+Valeur de retour :  indice linaire du point dans gPtr->ftbl
+
+Description : Convertit les coordonnes d'un point en indice du tableau dense.
+------------------------------------------------------------------------*/
+int64_t indiceGrille(GRILLE_PARAMETRES *gPtr, const int coord[])
+{
+    int64_t indice = 0;
+    int axe;
+
+    for(axe = 0; axe < NBR_AXES; axe = axe + 1)
+        indice = indice + coord[axe]*gPtr->pas[axe];
+    return(indice);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : coordonneesGrille
+Paramtres :
+    gPtr - pointeur rfrant  la grille
+    indice - indice linaire d'un point
+    coord - tableau o crire les coordonnes du point, une par axe
+Valeur de retour :  void
+
+Description : Inverse de indiceGrille().
+------------------------------------------------------------------------*/
+void coordonneesGrille(GRILLE_PARAMETRES *gPtr, int64_t indice, int coord[])
+{
+    int axe;
+
+    for(axe = 0; axe < NBR_AXES; axe = axe + 1)
+    {
+        coord[axe] = (int)(indice/gPtr->pas[axe]);
+        indice = indice % gPtr->pas[axe];
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheGrille
+Paramtres :
+    gPtr - pointeur rfrant  la grille calcule
+    duree - dure du calcul en secondes
+Valeur de retour :  void
+
+Description : Affiche les axes de la grille, le nombre de points de chaque statut, le
+dbit du calcul et les paramtres des facteurs de friction minimal et maximal.
+------------------------------------------------------------------------*/
+void afficheGrille(GRILLE_PARAMETRES *gPtr, double duree)
+{
+    int axe;
+    int coord[NBR_AXES];
+    int64_t extreme[2] = {gPtr->iMin, gPtr->iMax};
+    int ix;
+
+    printf("\n\nGrille de %.0f points :", (double)gPtr->nbrPoints);
+    for(axe = 0; axe < NBR_AXES; axe = axe + 1)
+        printf("\n%5c%-10s : %6d valeurs de %g \205 %g %s%s", ' ', nomAxe(axe), gPtr->axes[axe].nbr, gPtr->axes[axe].min,
+               gPtr->axes[axe].max, uniteAxe(axe), gPtr->axes[axe].nbr > 1 && gPtr->axes[axe].espacement == GRILLE_LOG ? " (log)" : "");
+    printf("\n%.0f points calcul\202s, %.0f sans racine, %.0f hors domaine (Reynolds < %d), %.0f sans convergence.",
+           (double)gPtr->nbrStatut[STATUT_OK], (double)gPtr->nbrStatut[STATUT_SANS_RACINE], (double)gPtr->nbrStatut[STATUT_ENTREE_INVALIDE],
+           VALEUR_MIN_REY, (double)gPtr->nbrStatut[STATUT_NON_CONVERGE]);
+    printf("\n%.0f \202valuations de Colebrook en %.3f s (%.1f millions de points/s).", (double)gPtr->nbrEval, duree, gPtr->nbrPoints/duree/1E6);
+
+    for(ix = 0; ix < 2; ix = ix + 1)
+    {
+        if(extreme[ix] >= 0)
+        {
+            coordonneesGrille(gPtr, extreme[ix], coord);
+            printf("\nf %s = %.6f pour", ix == 0 ? "minimal" : "maximal", gPtr->ftbl[extreme[ix]]);
+            for(axe = 0; axe < NBR_AXES; axe = axe + 1)
+                printf(" %s %g%s", nomAxe(axe), gPtr->axes[axe].valeurs[coord[axe]], axe < NBR_AXES - 1 ? "," : ".");
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : extraireCoupe
+Paramtres :
+    gPtr - pointeur rfrant  la grille calcule
+    dPtr - pointeur rfrant  la structure DONNEES  remplir
+Valeur de retour :  VRAI si la coupe est extraite, FAUX sinon
+
+Description : Copie dans dPtr la coupe de la grille selon le diamtre qui passe par le
+facteur de friction maximal (ou par l'origine de la grille si aucun point n'a t
+calcul), avec les autres paramtres de ce point. Comme le diamtre est le dernier axe,
+la coupe est contigu dans gPtr->ftbl. Les points sans solution gardent IMPOSSIBLE.
+------------------------------------------------------------------------*/
+int extraireCoupe(GRILLE_PARAMETRES *gPtr, DONNEES *dPtr)
+{
+    int coord[NBR_AXES];
+    AXE *axePtr = &gPtr->axes[AXE_DIAMETRE];
+
+    coordonneesGrille(gPtr, gPtr->iMax >= 0 ? gPtr->iMax : 0, coord);
+    coord[AXE_DIAMETRE] = 0;
+
+    dPtr->nbrPoints = axePtr->nbr;
+    if(allouerTableaux(dPtr) == FAUX)
+    {
+        dPtr->nbrPoints = 0; //les tableaux n'ont peut-tre pas la nouvelle taille
+        return(FAUX);
+    }
+    memcpy(dPtr->dtbl, axePtr->valeurs, axePtr->nbr*sizeof(double));
+    memcpy(dPtr->ftbl, &gPtr->ftbl[indiceGrille(gPtr, coord)], axePtr->nbr*sizeof(double));
+
+    dPtr->dmin = axePtr->min;
+    dPtr->dmax = axePtr->max;
+    dPtr->eps = gPtr->axes[AXE_RUGOSITE].valeurs[coord[AXE_RUGOSITE]];
+    dPtr->ro = gPtr->axes[AXE_DENSITE].valeurs[coord[AXE_DENSITE]];
+    dPtr->mu = gPtr->axes[AXE_VISCOSITE].valeurs[coord[AXE_VISCOSITE]];
+    dPtr->debit = gPtr->axes[AXE_DEBIT].valeurs[coord[AXE_DEBIT]];
+    calculerRey(dPtr);
+    dPtr->estVide = FAUX;
+    printf("\nGraphique : coupe selon le diam\212tre pour rugosit\202 %g, densit\202 %g, viscosit\202 %g, d\202bit %g.",
+           dPtr->eps, dPtr->ro, dPtr->mu, dPtr->debit);
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : libererGrille
+Paramtres :
+    gPtr - pointeur rfrant  la grille
+Valeur de retour :  void
+
+Description : Libre le tableau de la grille et les valeurs de ses axes.
+------------------------------------------------------------------------*/
+void libererGrille(GRILLE_PARAMETRES *gPtr)
+{
+    int axe;
+
+    free(gPtr->ftbl);
+    gPtr->ftbl = NULL;
+    for(axe = 0; axe < NBR_AXES; axe = axe + 1)
+    {
+        free(gPtr->axes[axe].valeurs);
+        gPtr->axes[axe].valeurs = NULL;
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : nomAxe
+Paramtres :
+    axe - numro de l'axe
+Valeur de retour :  nom - chane de caractres qui nomme le paramtre
+
+Description : Retourne le nom du paramtre d'un axe de la grille, pour l'affichage.
+------------------------------------------------------------------------*/
+char *nomAxe(int axe)
+{
+    char *nom;
+
+    if(axe == AXE_DEBIT)
+        nom = "d\202bit";
+    else if(axe == AXE_VISCOSITE)
+        nom = "viscosit\202";
+    else if(axe == AXE_DENSITE)
+        nom = "densit\202";
+    else if(axe == AXE_RUGOSITE)
+        nom = "rugosit\202";
+    else
+        nom = "diam\212tre";
+    return(nom);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : uniteAxe
+Paramtres :
+    axe - numro de l'axe
+Valeur de retour :  unite - chane de caractres de l'unit du paramtre
+
+Description : Retourne l'unit du paramtre d'un axe de la grille, pour l'affichage.
+------------------------------------------------------------------------*/
+char *uniteAxe(int axe)
+{
+    char *unite;
+
+    if(axe == AXE_DEBIT)
+        unite = "m^3/s";
+    else if(axe == AXE_VISCOSITE)
+        unite = "N*s/m^2";
+    else if(axe == AXE_DENSITE)
+        unite = "kg/m^3";
+    else
+        unite = "m";
+    return(unite);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixDonnees
+Paramtres :
+    dPtr - pointeur rfrant  la structure DONNEES donnees.
+    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
+    fPtr - pointeur rfrant  la structure FILE.
+    optPtr - pointeur rfrant  la structure OPTIONS.
+    errPtr - pointeur o crire l'erreur du balayage.
+Valeur de retour :  code de l'erreur du balayage, STATUT_OK si russi
+
+Description : Affiche le contenu du fichier (tableau de sauvegarde) et demande 
+l'utilisateur quelles donnes  choisir. Les tableaux, qui ne sont pas sauvegards,
+sont ensuite recalculs avec remplirTableaux().
+------------------------------------------------------------------------*/
+int choixDonnees(DONNEES tblPtr[], DONNEES *dPtr, FILE *fPtr, OPTIONS *optPtr, ERREUR_BALAYAGE *errPtr)
+{
+    int choix; //choix de l'utilisateur
+    if(tblPtr[0].estVide == VRAI)
+    {
+        printf("\nTout est vide. Vous devez entrer vos propres donn\202es.");
+        return(entrerDonnees(dPtr, tblPtr, fPtr, optPtr, errPtr));
+    }
+    else
+    {
+        afficheDonnees(tblPtr);
+        printf("\nVeuillez s\202lectionner un ensemble de donn\202es (1 \205 5) : ");
+
+        do //s'assure que le choix n'est pas vide
+        {
+            do //s'assure que l'entre est valide
+            {
+                fflush(stdin);
+                scanf("%d", &choix);
+
+                if(choix < 1 || choix > 5)
+                    printf("Entrez un chiffre de 1 \205 5 : ");
+            }
+            while( choix < 1 || choix > 5);  //choix invalide
+
+            if(tblPtr[choix - 1].estVide == VRAI) //si le choix est vide
+                printf("La s\202lection ne contient pas de donn\202es!\n");
+        }
+        while(tblPtr[choix - 1].estVide == VRAI);  //choix est vide
+
+        libererTableaux(dPtr); //les tableaux seront recalculs pour les donnes importes
+        *dPtr = tblPtr[choix - 1];
+        printf("\nLes donn\202es ont \202t\202 import\202es.\n");
+        return(remplirTableaux(dPtr, optPtr, errPtr));
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheDonnees
+Paramtres :
+    tblPtr - rfrence au tableau de sauvegarde (type DONNEES).
+Valeur de retour :  void
+
+Description : Affiche les donnes dans le tableau de sauvegarde.
+------------------------------------------------------------------------*/
+void afficheDonnees(DONNEES tblPtr[])
+{
+    int ix; //index de la structure  afficher
+
+    for(ix = 0; ix < NBR_SAUVER; ix = ix +1)
+    {
+        printf("\n %d) \n\n", ix+1);
+
+        if(tblPtr[ix].estVide == VRAI) //si membre est vide
+            printf("%20cVIDE\n", ' ');
+        else if(tblPtr[ix].estVide == FAUX) //si membre contient des donnes
+        {
+            printf("%5cDiam\212tre minimal (m)  : %.3g \n", ' ', tblPtr[ix].dmin);
+            printf("%5cDiam\212tre maximal (m)  : %g \n", ' ', tblPtr[ix].dmax);
+            printf("%5cNombre de diam\212tres   : %d \n", ' ', tblPtr[ix].nbrPoints);
+            printf("%5cRugosit\202 (m)          : %g \n", ' ', tblPtr[ix].eps);
+            printf("%5cDensit\202 (kg/m^3)      : %g \n", ' ', tblPtr[ix].ro);
+            printf("%5cViscosit\202 (N*s/m^2)   : %g \n", ' ', tblPtr[ix].mu);
+            printf("%5cD\202bit de flux (m^3/s) : %g \n\n", ' ', tblPtr[ix].debit);
+            printf("%5cNombre de Reynolds calcul\202       : %.3f \n", ' ', tblPtr[ix].rey);
+            printf("%5cVitesse du fluide calcul\202e (m/s) : %.3f \n", ' ', tblPtr[ix].vit);
+        }
+        printf("-----------------------------------------------\n");
+    }
+}
+
+/*------------
+Fonction :  entrerDonnees
+
+Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
+                tblPtr - pointeur rfrant le tableau de type DONNEES
+                fPtr - pointeur rfrant  la structure FILE
+                optPtr - pointeur rfrant  la structure OPTIONS
+                errPtr - pointeur o crire l'erreur du balayage
+
+Valeur de retour :  code de l'erreur du balayage, STATUT_OK si russi
+
+Description :   Cette fonction demande les entres de lutilisateur  l'aide de invitation().
+Pour les entres de dmax et dmin, vrifie si les valeurs sont acceptables en faisant appel 
+la fonction verifieDiam(). Le nombre de diamtres est demand par demandeNbrPoints(). Avec la
+grille gomtrique, le nombre de diamtres dcoule de la raison; avec une liste de diamtres,
+dmin, dmax et le nombre de diamtres sont tirs de la liste (voir preparerGrille()).
+Pour la viscosit, la densit, la rugosit et le dbit, la fonction doit vrifier si ces valeurs sont plus grandes que 0 en faisant appel  la fonction
+getValeurPositive(). Pour le nombre de Reynolds, on calcule sa valeur en appelant la fonction
+calculerRey(). Ensuite, fait appel  demandeSauver() pour offrir de sauvgarder les donnes si
+le balayage a russi.
+------------*/
+int entrerDonnees(DONNEES *dPtr, DONNEES *tblPtr, FILE *fPtr, OPTIONS *optPtr, ERREUR_BALAYAGE *errPtr)
+{
+    do
+    {
+        if(optPtr->grille == GRILLE_LISTE) //la liste donne les diamtres
+        {
+            dPtr->dmin = optPtr->listetbl[0];
+            dPtr->dmax = optPtr->listetbl[optPtr->nbrListe - 1];
+            dPtr->nbrPoints = optPtr->nbrListe;
+        }
+        else
+        {
+            do
+            {
+                //demande des valeurs des diamtres et vrification de ces valeurs
+                dPtr->dmax = invitation("le diam\212tre maximal en m");
+                dPtr->dmin = invitation("le diam\212tre minimal en m");
+            }
+            while(!verifieDiam(dPtr));
+            if(optPtr->grille != GRILLE_GEOMETRIQUE) //sinon, dduit de la raison par preparerGrille()
+                dPtr->nbrPoints = demandeNbrPoints();
+        }
+
+        //demande pour la valeur de la rugosit et vrification de cette valeur
+        dPtr->eps = invitation("la rugosit\202 du conduit en m");
+        //demande pour la valeur de la densit et vrification de cette valeur
+        dPtr->ro = invitation("la densit\202 du fluide en kg/m^3");
+        //demande pour la valeur de la viscosit et vrification de cette valeur
+        dPtr->mu = invitation("la viscosit\202 du fluide en N*s/m^2");
+        //demande pour la valeur du dbit et vrification de cette valeur
+        dPtr->debit = invitation("le d\202bit de flux du fluide en m^3/s");
+    }
+    while(!calculerRey(dPtr)); //vrifie que # de Reynolds > 4000
+    printf("Test r\202ussi : le nombre de Reynolds obtenu est %f.", dPtr->rey);
+
+    dPtr->estVide = FAUX; //la variable struct n'est plus vide
+
+    //vrifie que des facteurs de friction existent pour toute l'tendue et remplit tableaux si les valeurs sont valides
+    if(remplirTableaux(dPtr, optPtr, errPtr) == STATUT_OK)
+        demandeSauver(dPtr, tblPtr, fPtr);
+    return(errPtr->code);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : invitation
+Paramtres :
+    texte - chane de caractre qui corresond au nom de la variable que l'on demande de fournir.
+Valeur de retour :  valeur - valeur entre par l'utilisateur
+
+Description : Cette fonction demande  l'utilisisateur d'entrer une valeur. Retourne cette valeur  entrerDonnees()
+pour qu'elle soit affect  la variable approprie.
+------------------------------------------------------------------------*/
+double invitation(char texte[])
+{
+    double valeur;
+
+    do
+    {
+        printf("\nVeuillez entrer la valeur pour %s : ", texte);
+        fflush(stdin);
+        scanf("%lf", &valeur);
+    }
+    while(!getValeurPositive(valeur)); //rpte si valeur ngative
+
+    return(valeur);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : demandeSauver
+Paramtres :
+    dPtr - pointeur rfrant  la structure DONNEES
+    tblPtr - pointeur rfrant le tableau de type DONNEES
+    fPtr - pointeur rfrant  la structure FILE
+Valeur de retour :  void
+
+Description : Cette fonction demande  l'utilisateur s'il veut sauvegarder ses donnes. Si oui,
+fait appel  sauverDonnees; si non, rpte la demande.
+------------------------------------------------------------------------*/
+void demandeSauver(DONNEES *dPtr, DONNEES *tblPtr, FILE *fPtr)
+{
+    char reponse; //rponse de l'utilisateur
+    printf("\n\nVoulez-vous sauver vos donn\202es?");
+    printf("\nR\202pondre 'o' pour oui et 'n' pour non : ");
+    fflush(stdin);
+    scanf("%c", &reponse);
+    while(reponse != 'o' && reponse != 'n')//s'assure que l'utilisateur entre un caractre valide
+    {
+        printf(" - ERREUR! Le caract\212re n'est pas valide. S.V.P r\202pondre 'o' ou 'n' : ");
+        fflush(stdin);
+        scanf("%c", &reponse);
+    }
+    if(reponse == 'o')
+        sauverDonnees(dPtr, tblPtr, fPtr); //sauve les donnes
+}
+
+/*------------
+Fonction :  sauverDonnees
+
+Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
+                tblPtr - pointeur rfrant le tableau de type DONNEES
+                fPtr - pointeur rfrant  la structure FILE
+Valeur de retour :  void
+
+Description :   Cette fonction sauvegarde les donnes de l'utilisateur dans le premier espace vide
+ l'intrieur du fichier binaire. Si il n'y a pas d'espace vide dans le fichier, la
+fonction fait appel  afficheDonnees. Ensuite, la fonction demande  l'utilisateur
+quel membre qu'il veut remplacer et sauve ses donnes  ce membre.
+------------*/
+void sauverDonnees(DONNEES *dPtr, DONNEES tblPtr[], FILE *fPtr)
+{
+    int ix; // Index pour la boucle
+    int ixVide = -1; // Pour l'index du tableau du 1er membre vide retrouv par la boucle
+    int choix; // Choix pour le numro du membre  remplacer
+
+    for(ix = 0; ix < NBR_SAUVER && ixVide == -1; ix = ix +1)
+    {
+        if(tblPtr[ix].estVide == VRAI) //si c'est vide, sauve les donnees dans le premier membre vide
+        {
+            tblPtr[ix] = *dPtr;
+            ixVide = ix;
+        }
+    }
+    if(ixVide == -1) //aucun membre vide trouv
+    {
+        afficheDonnees(tblPtr);
+        printf("Le fichier est plein. \nS.V.P. choisir le membre que vous voulez remplacer par vos donn\202es (1-5) : ");
+        fflush(stdin);
+        scanf("%d", &choix);
+        ix = choix;
+        tblPtr[ix-1] = *dPtr;
+    }
+    tblPtr[ix-1].dtbl = NULL; //les tableaux ne sont pas sauvegards
+    tblPtr[ix-1].ftbl = NULL;
+    ecrireFichier(tblPtr, fPtr); //sauve dans le fichier
+    printf("\nVos donn\202es ont \202t\202 sauv\202es dans le membre %d du fichier.", ix);
+
+}
+
+/*------------
+Fonction :  verifieDiam
+
+Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
+Valeur de retour :  bonDiam - VRAI si diamtres sont valides, FAUX autrement
+
+Description :   Cette fonction vrifie les valeurs de dmax et de dmin
+sont valides (dmax > dmin). Affiche message si les donnes sont invalides.
+------------*/
+int verifieDiam(DONNEES *dPtr)
+{
+    int bonDiam = VRAI; //drapeau
+    if(dPtr->dmax <= dPtr->dmin) //diamtres invalides
+    {
+        printf(" - ERREUR! Les valeurs du diam\212tre maximal et du diam\212tre minimal sont invalides.");
+        printf("\n - S.V.P. entrez des valeurs telles que le diam\212tre maximal est plus grand que le diam\212tre minimal.\n");
+        bonDiam = FAUX;
+    }
+    return(bonDiam);
+}
+
+/*------------
+Fonction :  demandeNbrPoints
+
+Paramtres :    (aucun)
+Valeur de retour :  nbrPoints - nombre de diamtres  calculer
+
+Description :   Cette fonction demande le nombre de diamtres  calculer dans l'tendue,
+ l'aide de invitation(), jusqu' ce que verifieNbrPoints() accepte la valeur.
+------------*/
+int demandeNbrPoints()
+{
+    double valeur; //valeur entre par l'utilisateur
+
+    do
+        valeur = invitation("le nombre de diam\212tres \205 calculer");
+    while(!verifieNbrPoints(valeur));
+
+    return((int)valeur);
+}
+
+/*------------
+Fonction :  verifieNbrPoints
+
+Paramtres :    valeur - nombre de diamtres entr par l'utilisateur
+Valeur de retour :  int (VRAI ou FAUX)
+
+Description :   Cette fonction vrifie que le nombre de diamtres est un entier
+entre NBR_POINTS_MIN et NBR_POINTS_MAX. Affiche un message si la valeur est invalide.
+------------*/
+int verifieNbrPoints(double valeur)
+{
+    if(valeur < NBR_POINTS_MIN || valeur > NBR_POINTS_MAX || valeur != floor(valeur))
+    {
+        printf(" - ERREUR! Le nombre de diam\212tres doit \210tre un entier entre %d et %.0f.", NBR_POINTS_MIN, NBR_POINTS_MAX);
+        return(FAUX);
+    }
+    return(VRAI);
+}
+
+/*------------
+Fonction :  getValeurPositive
+
+Paramtres :    valeur - valeur envoye par entrerDonnees
+Valeur de retour :  int (VRAI ou FAUX)
+
+Description :   Cette fonction vrifie si les valeurs sont valides ( > 0 ). La
+fonction affiche un message si les valeurs sont invalides et retourne FAUX,
+sinon retourne VRAI.
+------------*/
+int getValeurPositive(double valeur)
+{
+    if (valeur < 0)
+    {
+        printf(" - ERREUR! La valeur fournie n'est pas valide. Elle doit \210tre plus grande que z\202ro.");
+
+        return(FAUX);
+    }
+    return(VRAI);
+}
+
+/*------------
+Fonction :  calculerRey
+
+Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
+Valeur de retour :  int (VRAI ou FAUX)
+
+Description :   Cette fonction calcule le nombre de Reynolds et vrifie si ce nombre est valide
+( > VALEUR_MIN_REY ). Si le nombre de Reynolds est plus petit que 4000, la fonction
+affiche un message que la valeur n'est pas valide et retourne FAUX. Sinon, retourne VRAI.
+------------*/
+int calculerRey(DONNEES *dPtr)
+{
+    //calcul de la vitesse
+    dPtr->vit = pow((0.5*dPtr->dmax), 2); /*Diamtre maximal donnera la vitesse minimale,
+                                            qui donnera le nombre de Reynolds minimal qu'atteint
+                                            la fonction*/
+    dPtr->vit = dPtr->vit * M_PI;
+    dPtr->vit = dPtr->debit / dPtr->vit;
+
+    //calcul du nombre de Reynolds
+    dPtr->rey = dPtr->ro * dPtr->vit * dPtr->dmax;
+    dPtr->rey = dPtr->rey / dPtr->mu;
+
+    if(dPtr->rey < VALEUR_MIN_REY) //Reynold < 4000
+    {
+        printf("\nLa valeur obtenue pour le nombre de Reynolds, soit %.4f, n'est pas valide car elle est plus petite que 4000.", dPtr->rey);
+        printf("\nVous devez entrer vos valeurs de nouveau afin que le nombre de Reynolds soit plus grand que 4000.");
+        return(FAUX);
+    }
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : remplirTableaux
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    errPtr - pointeur o crire l'erreur du balayage
+Valeur de retour :  errPtr->code, STATUT_OK si le tout est acceptable
+
+Description : Cette fonction vrifie d'abord par verifierFaisabilite() qu'une racine existe
+pour tous les diamtres, sans rien rsoudre, puis alloue et remplit les tableaux du diamtre et
+du facteur de friction, de taille dPtr->nbrPoints, selon la grille choisie (voir
+preparerGrille() et remplirDiametres()). Les facteurs de friction sont
+calculs par resoudreIntervalle(), ou par balayageParallele() lorsque plusieurs
+fils d'excution sont permis. Avec l'chantillonnage adaptatif, les diamtres sont
+choisis par echantillonnageAdaptatif() et dPtr->nbrPoints devient le nombre de
+diamtres rellement calculs. Ces tableaux seront utilises pour le graphique. En flux,
+les rsultats passent plutt par balayageFlux() et les tableaux ne gardent que les
+points du graphique. En cas d'chec, l'erreur est dcrite dans errPtr et c'est  l'appelant
+de redemander les donnes. Hors flux, le rsultat du balayage prcdent est rutilis selon
+les entres qui ont chang (voir comparerCache()) : les diamtres sont repris si la grille
+n'a pas chang, et rien n'est rsolu si aucune entre de f n'a chang.
+------------------------------------------------------------------------*/
+int remplirTableaux(DONNEES *dPtr, OPTIONS *optPtr, ERREUR_BALAYAGE *errPtr)
+{
+    int echec; //indice du premier point sans racine, ou -1
+    int nbrDemandes; //nombre de diamtres demand, avant l'chantillonnage adaptatif
+    int reutilisation = REUTILISATION_AUCUNE; //part du balayage prcdent qui est reprise
+    CACHE_BALAYAGE *cachePtr = optPtr->cachePtr;
+    long totalEval = 0; //nombre total d'valuations de Colebrook
+    double debut; //temps au dbut du calcul
+
+    FILE *fluxPtr = NULL; //destination des paires (diamtre, f) en flux
+
+    optPtr->resPtr->nbrTraces = 0;
+    errPtr->code = STATUT_OK;
+    errPtr->d = 0;
+    if(preparerGrille(dPtr, optPtr) == FAUX) //grille invalide pour ces donnes
+        errPtr->code = STATUT_ENTREE_INVALIDE;
+    else if(verifierFaisabilite(dPtr, optPtr, errPtr) == FAUX) //aucune racine  une extrmit, rien n'est rsolu
+        return(errPtr->code);
+    if(errPtr->code != STATUT_OK)
+        return(errPtr->code);
+
+    if(optPtr->memoisation == VRAI) //les compteurs ne portent que sur ce balayage
+    {
+        optPtr->memoPtr->nbrTrouves = 0;
+        optPtr->memoPtr->nbrManques = 0;
+    }
+    nbrDemandes = dPtr->nbrPoints;
+    if(optPtr->flux == SANS_FLUX && cachePtr != NULL)
+    {
+        reutilisation = comparerCache(cachePtr, dPtr, optPtr);
+        if(reutilisation == REUTILISATION_TOTALE) //garde aussi les diamtres de l'chantillonnage adaptatif
+            dPtr->nbrPoints = cachePtr->nbrPoints;
+    }
+
+    if(optPtr->flux != SANS_FLUX) //flux : mmoire constante, quel que soit le nombre de diamtres
+    {
+        if(optPtr->flux == FLUX_FICHIER && (fluxPtr = fopen(FICHIER_FLUX, "w")) == NULL)
+            printf("\n - ERREUR! Impossible d'ouvrir %s, seuls le minimum et le maximum seront gard\202s.", FICHIER_FLUX);
+        else if(optPtr->flux == FLUX_SORTIE)
+            fluxPtr = stdout;
+
+        debut = chrono();
+        echec = balayageFlux(dPtr, optPtr, fluxPtr != NULL ? puitsTexte : NULL, fluxPtr, &totalEval);
+        debut = chrono() - debut;
+        if(fluxPtr != NULL && fluxPtr != stdout)
+            fclose(fluxPtr);
+    }
+    else if(allouerTableaux(dPtr) == FAUX || allouerResultats(optPtr->resPtr, dPtr->nbrPoints, optPtr) == FAUX) //mmoire insuffisante
+    {
+        errPtr->code = STATUT_MEMOIRE;
+        return(errPtr->code);
+    }
+
+    else
+    {
+        //remplit le tableau des diamtres, ou reprend ceux du balayage prcdent
+        if(reutilisation != REUTILISATION_AUCUNE)
+            memcpy(dPtr->dtbl, cachePtr->dtbl, dPtr->nbrPoints*sizeof(double));
+        else
+            remplirDiametres(dPtr, optPtr, dPtr->nbrPoints);
+
+        //calcul les valeurs de friction et remplit le tableau
+        debut = chrono();
+        if(reutilisation == REUTILISATION_TOTALE) //aucune rsolution, seuls les rsultats par point sont refaits
+        {
+            optPtr->anciennetbl = cachePtr->ftbl;
+            echec = resoudreIntervalle(dPtr, optPtr, 0, dPtr->nbrPoints, &totalEval);
+            optPtr->anciennetbl = NULL;
+        }
+        else if(optPtr->echantillonnage == ADAPTATIF && optPtr->grille <= GRILLE_LOG && dPtr->nbrPoints > POINTS_INITIAUX)
+            echec = echantillonnageAdaptatif(dPtr, optPtr, &totalEval);
+        else if(optPtr->nbrFils > 1 && dPtr->nbrPoints >= 2*POINTS_MIN_PAR_FIL)
+            echec = balayageParallele(dPtr, optPtr, &totalEval);
+        else
+            echec = resoudreIntervalle(dPtr, optPtr, 0, dPtr->nbrPoints, &totalEval);
+        debut = chrono() - debut;
+    }
+
+    if(echec >= 0)//facteur de friction impossible malgr la vrification (corrlation explicite ou non-convergence)
+    {
+        errPtr->code = (dPtr->ftbl[echec] == NON_CONVERGE) ? STATUT_NON_CONVERGE : STATUT_SANS_RACINE;
+        errPtr->d = dPtr->dtbl[echec];
+        errPtr->rey = reyPoint(dPtr, optPtr, errPtr->d);
+        errPtr->rugRel = dPtr->eps/errPtr->d;
+        return(errPtr->code);
+    }
+    printf("\n%ld \202valuations de Colebrook (%.1f par diam\212tre) en %.3f s (%.1f millions de diam\212tres/s).",
+           totalEval, (double)totalEval/dPtr->nbrPoints, debut, dPtr->nbrPoints/debut/1E6);
+    if(optPtr->memoisation == VRAI)
+        afficheMemo(optPtr->memoPtr);
+    if(optPtr->flux != SANS_FLUX)
+    {
+        printf("\nFlux (%s) : %d diam\212tres en morceaux de %d, f de %.6f \205 %.6f, %d points gard\202s pour le graphique.",
+               nomFlux(optPtr->flux), dPtr->nbrPoints, TAILLE_MORCEAU, optPtr->resPtr->fMin, optPtr->resPtr->fMax, optPtr->resPtr->nbrTraces);
+        return(STATUT_OK);
+    }
+    if(optPtr->methode == NEWTON && (optPtr->suivi == VRAI || optPtr->memoisation == VRAI)) //le suivi et la mmosation forcent le calcul scalaire
+        printf("\nNoyau de Newton : %s, %s.", nomNoyau(NOYAU_SCALAIRE), nomPrecision(PRECISION_DOUBLE));
+    else if(optPtr->methode == NEWTON)
+        printf("\nNoyau de Newton : %s, %s.", precisionNewton(optPtr) == PRECISION_DOUBLE ? nomNoyau(optPtr->noyauChoisi) : "vectoriel float",
+               nomPrecision(precisionNewton(optPtr)));
+    if(optPtr->methode >= HAALAND || (optPtr->methode == NEWTON && precisionNewton(optPtr) != PRECISION_DOUBLE)) //approximation, rapporte l'erreur
+        afficheErreurExplicite(dPtr, optPtr);
+    if(optPtr->suivi == VRAI)
+        afficheSuivi(dPtr, optPtr->resPtr);
+    if(optPtr->reyVariable == VRAI)
+        printf("\nNombre de Reynolds de %.1f (d = %g m) \205 %.1f (d = %g m).", optPtr->resPtr->reytbl[dPtr->nbrPoints - 1],
+               dPtr->dtbl[dPtr->nbrPoints - 1], optPtr->resPtr->reytbl[0], dPtr->dtbl[0]);
+    if(optPtr->sensibilites == VRAI)
+        afficheSensibilites(dPtr, optPtr->resPtr);
+    if(cachePtr != NULL)
+    {
+        afficheReutilisation(cachePtr, reutilisation, dPtr, totalEval);
+        if(reutilisation != REUTILISATION_TOTALE) //sinon, le cache correspond dj  ces entres
+            memoriserCache(cachePtr, dPtr, optPtr, nbrDemandes, totalEval);
+    }
+    return(STATUT_OK);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : verifierFaisabilite
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    errPtr - pointeur o crire le point sans racine
+Valeur de retour :  VRAI si une racine existe pour tous les diamtres, FAUX sinon
+
+Description : Vrifie, avant toute rsolution, que Colebrook change de signe sur
+l'intervalle PRESQUE_0  HAUT des mthodes itratives pour chaque diamtre de la grille.
+En x = 1/sqrt(f), g(x) = x + 2*log10(eps/(3.7*d) + 2.51*x/rey) est toujours positive 
+x = 1/sqrt(PRESQUE_0) (le logarithme d'un double ne descend pas sous -700); il reste 
+vrifier g(1/sqrt(HAUT)) < 0. L'argument du logarithme vaut eps/(3.7*d) plus un terme
+constant, ou linaire en d si le nombre de Reynolds varie avec le diamtre (rey = 4*ro*Q/(pi*mu*d)) :
+il est convexe en d, donc son maximum sur la grille est atteint au premier ou au dernier
+diamtre. Ces deux valuations suffisent pour toute la grille.
+------------------------------------------------------------------------*/
+int verifierFaisabilite(DONNEES *dPtr, OPTIONS *optPtr, ERREUR_BALAYAGE *errPtr)
+{
+    int ix; //0 pour le premier diamtre, 1 pour le dernier
+    double d, rey; //diamtre extrme et son nombre de Reynolds
+    double gPrime; //drive de Colebrook, non utilise
+
+    for(ix = 0; ix < 2; ix = ix + 1)
+    {
+        d = diametreGrille(dPtr, optPtr, ix*(dPtr->nbrPoints - 1), dPtr->nbrPoints);
+        rey = reyPoint(dPtr, optPtr, d);
+        if(!(calculColebrookX(1/sqrt(HAUT), rey, dPtr->eps/d, &gPrime) < 0)) //aussi vrai si g n'est pas un nombre
+        {
+            errPtr->code = STATUT_SANS_RACINE;
+            errPtr->d = d;
+            errPtr->rey = rey;
+            errPtr->rugRel = dPtr->eps/d;
+            return(FAUX);
+        }
+    }
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheErreurBalayage
+Paramtres :
+    errPtr - pointeur rfrant  l'erreur rendue par remplirTableaux()
+Valeur de retour :  void
+
+Description : Explique  l'utilisateur pourquoi le balayage des diamtres a chou.
+------------------------------------------------------------------------*/
+void afficheErreurBalayage(ERREUR_BALAYAGE *errPtr)
+{
+    if(errPtr->code == STATUT_MEMOIRE)
+        printf("\nLe balayage demande plus de m\202moire que disponible, r\202duisez le nombre de diam\212tres.\n");
+    else if(errPtr->code == STATUT_ENTREE_INVALIDE)
+        printf("\nLa grille choisie ne convient pas \205 ces donn\202es.\n");
+    else
+    {
+        printf("\n\nLes donn\202es entr\202es sont irr\202alistes! \nDes facteurs de frictions n'existent pas pour tout l'\202tendue des diam\212tres donn\202e.");
+        if(errPtr->code == STATUT_NON_CONVERGE)
+            printf("\nLa m\202thode n'a pas converg\202 pour le diam\212tre %g m", errPtr->d);
+        else
+            printf("\nAucune racine pour le diam\212tre %g m", errPtr->d);
+        printf(" (Re = %.1f, eps/d = %g).", errPtr->rey, errPtr->rugRel);
+        printf("\nVous devez utiliser des donn\202es r\202alistes.\n");
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : signatureCache
+Paramtres :
+    sigPtr - pointeur o crire les entres du balayage
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  void
+
+Description : Relve toutes les entres dont dpendent les diamtres et les facteurs de
+friction du balayage, sans toucher aux tableaux de sigPtr. Les options qui ne changent
+pas le rsultat au-del du critre d'arrt (fils, noyau, continuation) n'en font pas partie.
+------------------------------------------------------------------------*/
+void signatureCache(CACHE_BALAYAGE *sigPtr, DONNEES *dPtr, OPTIONS *optPtr)
+{
+    int ix;
+
+    sigPtr->grille = optPtr->grille;
+    sigPtr->echantillonnage = optPtr->echantillonnage;
+    sigPtr->nbrDemandes = dPtr->nbrPoints;
+    sigPtr->dmin = dPtr->dmin;
+    sigPtr->dmax = dPtr->dmax;
+    sigPtr->raison = optPtr->raison;
+    sigPtr->tolEchantillon = optPtr->tolEchantillon;
+    sigPtr->eps = dPtr->eps;
+    sigPtr->reyVariable = optPtr->reyVariable;
+    sigPtr->rey = dPtr->rey;
+    sigPtr->ro = dPtr->ro;
+    sigPtr->mu = dPtr->mu;
+    sigPtr->debit = dPtr->debit;
+    sigPtr->methode = optPtr->methode;
+    sigPtr->precision = precisionNewton(optPtr); //prcision rellement utilise
+    sigPtr->critere = optPtr->critere;
+    for(ix = 0; ix < 4; ix = ix + 1)
+        sigPtr->paramMethode[ix] = 0;
+    if(optPtr->methode == TABLE_BICUBIQUE && optPtr->tablePtr->xtbl != NULL)
+        sigPtr->paramMethode[0] = optPtr->tablePtr->noeudsParDecade;
+    else if(optPtr->methode == CHEBYSHEV && optPtr->substitutPtr->coef != NULL)
+    {
+        sigPtr->paramMethode[0] = optPtr->substitutPtr->reyMin;
+        sigPtr->paramMethode[1] = optPtr->substitutPtr->reyMax;
+        sigPtr->paramMethode[2] = optPtr->substitutPtr->rugMin;
+        sigPtr->paramMethode[3] = optPtr->substitutPtr->rugMax;
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : comparerCache
+Paramtres :
+    cachePtr - pointeur rfrant au dernier balayage russi
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  REUTILISATION_AUCUNE, REUTILISATION_GRILLE ou REUTILISATION_TOTALE
+
+Description : Dtermine quelle part du dernier balayage reste valide pour les entres
+actuelles. Les diamtres dpendent de la grille, de dmin, dmax, du nombre de diamtres,
+de la raison (grille gomtrique) ou de la liste, et de l'chantillonnage. Les facteurs de
+friction dpendent en plus de eps, du nombre de Reynolds (ro, mu et debit s'il varie avec le
+diamtre, rey sinon) et de la mthode. Si seuls les facteurs de friction sont touchs, les
+diamtres sont repris mais f est recalcul : partir de l'ancien f de chaque point cote plus
+d'valuations que la continuation et les noyaux vectoriels. L'chantillonnage adaptatif place
+ses diamtres selon f : il n'est repris que si rien n'a chang.
+------------------------------------------------------------------------*/
+int comparerCache(CACHE_BALAYAGE *cachePtr, DONNEES *dPtr, OPTIONS *optPtr)
+{
+    CACHE_BALAYAGE sig; //entres actuelles
+    int memeGrille, memeFriction; //drapeaux : les diamtres, les facteurs de friction sont inchangs
+
+    if(cachePtr->valide == FAUX)
+        return(REUTILISATION_AUCUNE);
+    signatureCache(&sig, dPtr, optPtr);
+
+    memeGrille = sig.grille == cachePtr->grille && sig.echantillonnage == cachePtr->echantillonnage
+                 && sig.nbrDemandes == cachePtr->nbrDemandes && sig.dmin == cachePtr->dmin && sig.dmax == cachePtr->dmax
+                 && (sig.grille != GRILLE_GEOMETRIQUE || sig.raison == cachePtr->raison)
+                 && (sig.echantillonnage != ADAPTATIF || sig.tolEchantillon == cachePtr->tolEchantillon);
+    if(memeGrille && sig.grille == GRILLE_LISTE) //la liste elle-mme, qui est le tableau des diamtres
+        memeGrille = memcmp(optPtr->listetbl, cachePtr->dtbl, cachePtr->nbrPoints*sizeof(double)) == 0;
+
+    memeFriction = sig.eps == cachePtr->eps && sig.reyVariable == cachePtr->reyVariable
+                   && (sig.reyVariable == VRAI ? (sig.ro == cachePtr->ro && sig.mu == cachePtr->mu && sig.debit == cachePtr->debit)
+                                               : sig.rey == cachePtr->rey)
+                   && sig.methode == cachePtr->methode && sig.precision == cachePtr->precision
+                   && sig.critere.tolAbs == cachePtr->critere.tolAbs && sig.critere.tolRel == cachePtr->critere.tolRel
+                   && sig.critere.iterMax == cachePtr->critere.iterMax
+                   && memcmp(sig.paramMethode, cachePtr->paramMethode, sizeof(sig.paramMethode)) == 0;
+
+    if(!memeGrille)
+        return(REUTILISATION_AUCUNE);
+    if(memeFriction)
+        return(REUTILISATION_TOTALE);
+    if(sig.echantillonnage == ADAPTATIF && sig.grille <= GRILLE_LOG && sig.nbrDemandes > POINTS_INITIAUX) //diamtres choisis selon f
+        return(REUTILISATION_AUCUNE);
+    return(REUTILISATION_GRILLE);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : memoriserCache
+Paramtres :
+    cachePtr - pointeur rfrant au dernier balayage russi
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    nbrDemandes - nombre de diamtres demand pour ce balayage
+    nbrEval - nombre d'valuations de Colebrook du balayage
+Valeur de retour :  void
+
+Description : Copie les diamtres et les facteurs de friction d'un balayage russi, avec
+les entres dont ils dpendent. Si la mmoire manque, le cache est simplement invalid.
+------------------------------------------------------------------------*/
+void memoriserCache(CACHE_BALAYAGE *cachePtr, DONNEES *dPtr, OPTIONS *optPtr, int nbrDemandes, long nbrEval)
+{
+    double *dtbl, *ftbl; //nouveaux tableaux
+
+    cachePtr->valide = FAUX;
+    dtbl = reallouerTableau(cachePtr->dtbl, dPtr->nbrPoints, sizeof(double));
+    if(dtbl != NULL)
+        cachePtr->dtbl = dtbl;
+    ftbl = reallouerTableau(cachePtr->ftbl, dPtr->nbrPoints, sizeof(double));
+    if(ftbl != NULL)
+        cachePtr->ftbl = ftbl;
+    if(dtbl == NULL || ftbl == NULL)
+        return;
+
+    signatureCache(cachePtr, dPtr, optPtr);
+    cachePtr->nbrDemandes = nbrDemandes;
+    cachePtr->nbrPoints = dPtr->nbrPoints;
+    memcpy(cachePtr->dtbl, dPtr->dtbl, dPtr->nbrPoints*sizeof(double));
+    memcpy(cachePtr->ftbl, dPtr->ftbl, dPtr->nbrPoints*sizeof(double));
+    cachePtr->nbrEval = nbrEval;
+    cachePtr->valide = VRAI;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheReutilisation
+Paramtres :
+    cachePtr - pointeur rfrant au balayage prcdent
+    reutilisation - part reprise du balayage prcdent (REUTILISATION_AUCUNE ... REUTILISATION_TOTALE)
+    dPtr - pointeur rfrant  la structure de donnes.
+    nbrEval - nombre d'valuations de Colebrook du balayage actuel
+Valeur de retour :  void
+
+Description : Indique ce qui a t repris du balayage prcdent et le travail conomis.
+------------------------------------------------------------------------*/
+void afficheReutilisation(CACHE_BALAYAGE *cachePtr, int reutilisation, DONNEES *dPtr, long nbrEval)
+{
+    if(reutilisation == REUTILISATION_TOTALE)
+        printf("\nRecalcul incr\202mental : aucune entr\202e de f n'a chang\202, %d diam\212tres et facteurs de friction repris (%ld \202valuations de Colebrook \202vit\202es).",
+               dPtr->nbrPoints, cachePtr->nbrEval);
+    else if(reutilisation == REUTILISATION_GRILLE)
+        printf("\nRecalcul incr\202mental : %d diam\212tres repris, facteurs de friction recalcul\202s (%ld \202valuations, contre %ld au balayage pr\202c\202dent).",
+               dPtr->nbrPoints, nbrEval, cachePtr->nbrEval);
+    else if(cachePtr->valide == VRAI)
+        printf("\nRecalcul incr\202mental : les diam\212tres ont chang\202, rien n'est repris du balayage pr\202c\202dent.");
+}
+
+/*-----------------------------------------------------------------------
+Fonction : libererCache
+Paramtres :
+    cachePtr - pointeur rfrant au dernier balayage russi
+Valeur de retour :  void
+
+Description : Libre les tableaux du cache et l'invalide.
+------------------------------------------------------------------------*/
+void libererCache(CACHE_BALAYAGE *cachePtr)
+{
+    free(cachePtr->dtbl);
+    free(cachePtr->ftbl);
+    cachePtr->dtbl = NULL;
+    cachePtr->ftbl = NULL;
+    cachePtr->valide = FAUX;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixMemo
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  void
+
+Description : Active ou dsactive la mmosation persistante.  la premire activation,
+la table est cre et charge pour le critre d'arrt courant; si le critre a chang
+depuis, la table est recharge pour le nouveau critre (voir chargerMemo()).
+------------------------------------------------------------------------*/
+void choixMemo(OPTIONS *optPtr)
+{
+    optPtr->memoisation = demandeOuiNon("Conserver les facteurs de friction calcul\202s d'un lancement \205 l'autre (calcul scalaire)?");
+    if(optPtr->memoisation == FAUX)
+        return;
+    if(optPtr->memoPtr->cases == NULL)
+    {
+        if(ouvrirMemo(optPtr->memoPtr, &optPtr->critere) == FAUX)
+        {
+            printf("M\202moire insuffisante pour la m\202mo\213sation.\n");
+            optPtr->memoisation = FAUX;
+            return;
+        }
+        chargerMemo(optPtr->memoPtr, &optPtr->critere);
+    }
+    else if(!memeCritere(&optPtr->memoPtr->critere, &optPtr->critere))
+        chargerMemo(optPtr->memoPtr, &optPtr->critere);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : chargerMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO ouverte
+    critPtr - critre d'arrt avec lequel les entres seront calcules
+Valeur de retour :  void
+
+Description : Vide la table et la complte par FICHIER_MEMO pour le critre critPtr. Les
+entres d'un autre critre ne sont pas interchangeables : les nouvelles entres de
+l'ancien critre sont d'abord crites dans FICHIER_MEMO. L'appelant doit avoir l'accs
+exclusif  la table.
+------------------------------------------------------------------------*/
+void chargerMemo(MEMO *mPtr, const CRITERE *critPtr)
+{
+    long nbr; //nombre d'entres lues
+
+    if(mPtr->nbrNouveaux > 0 && ecrireMemo(mPtr) == FAUX)
+        printf("Impossible d'\202crire la m\202mo\213sation dans %s.\n", FICHIER_MEMO);
+    memset(mPtr->cases, 0, mPtr->nbrCases*sizeof(ENTREE_MEMO));
+    mPtr->nbrEntrees = 0;
+    mPtr->nbrTrouves = 0;
+    mPtr->nbrManques = 0;
+    mPtr->nbrNouveaux = 0;
+    mPtr->critere = *critPtr;
+
+    nbr = lireMemo(mPtr);
+    if(nbr >= 0)
+        printf("%ld facteurs de friction lus dans %s.\n", nbr, FICHIER_MEMO);
+    else
+        printf("%s absent ou calcul\202 avec un autre crit\212re d'arr\210t : la m\202mo\213sation commence vide.\n", FICHIER_MEMO);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+Valeur de retour :  void
+
+Description : Affiche les compteurs de la mmosation pour le dernier balayage ou la
+dernire grille, et le nombre d'entres connues.
+------------------------------------------------------------------------*/
+void afficheMemo(MEMO *mPtr)
+{
+    printf("\nM\202mo\213sation : %ld facteurs de friction trouv\202s, %ld calcul\202s (%.1f %% trouv\202s), %ld connus.",
+           mPtr->nbrTrouves, mPtr->nbrManques,
+           100.0*mPtr->nbrTrouves/(mPtr->nbrTrouves + mPtr->nbrManques + (mPtr->nbrTrouves + mPtr->nbrManques == 0)),
+           mPtr->nbrEntrees);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : ouvrirMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+    critPtr - critre d'arrt avec lequel les entres seront calcules
+Valeur de retour :  VRAI si la table est alloue, FAUX sinon
+
+Description : Alloue une table de hachage vide de MEMO_CASES_MIN cases.
+------------------------------------------------------------------------*/
+int ouvrirMemo(MEMO *mPtr, const CRITERE *critPtr)
+{
+    mPtr->cases = calloc(MEMO_CASES_MIN, sizeof(ENTREE_MEMO));
+    if(mPtr->cases == NULL)
+        return(FAUX);
+    mPtr->nbrCases = MEMO_CASES_MIN;
+    mPtr->nbrEntrees = 0;
+    mPtr->critere = *critPtr;
+    pthread_rwlock_init(&mPtr->verrou, NULL);
+    mPtr->nbrTrouves = 0;
+    mPtr->nbrManques = 0;
+    mPtr->nbrNouveaux = 0;
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : lireMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+Valeur de retour :  nombre d'entres du fichier, ou -1 si le fichier manque ou ne convient pas
+
+Description : Ajoute  la table les entres de FICHIER_MEMO qu'elle ne contient pas encore.
+Le fichier est refus si l'identifiant, la version, la taille ou le critre d'arrt ne
+correspondent pas. Le fichier n'est jamais modifi en place (voir ecrireMemo()) : plusieurs
+processus peuvent le lire en mme temps. L'appelant doit avoir l'accs exclusif  la table.
+------------------------------------------------------------------------*/
+long lireMemo(MEMO *mPtr)
+{
+    ENTETE_MEMO entete = {0};
+    ENTREE_MEMO morceau[TAILLE_MORCEAU]; //entres lues  la fois
+    CRITERE critere; //critre du fichier
+    FILE *fPtr;
+    long nbrLus = 0; //nombre d'entres lues
+    long nbr; //nombre d'entres du morceau
+    int ix;
+
+    fPtr = fopen(FICHIER_MEMO, "rb");
+    if(fPtr == NULL)
+        return(-1);
+    if(fread(&entete, sizeof(ENTETE_MEMO), 1, fPtr) != 1)
+        entete.magique = 0;
+    critere.tolAbs = entete.tolAbs;
+    critere.tolRel = entete.tolRel;
+    critere.iterMax = entete.iterMax;
+    if(entete.magique != MEMO_MAGIQUE || entete.version != MEMO_VERSION || entete.nbrEntrees < 0 || !memeCritere(&critere, &mPtr->critere))
+    {
+        fclose(fPtr);
+        return(-1);
+    }
+
+    while(nbrLus < entete.nbrEntrees && (nbr = fread(morceau, sizeof(ENTREE_MEMO), TAILLE_MORCEAU, fPtr)) > 0)
+    {
+        for(ix = 0; ix < nbr; ix = ix + 1)
+            placerMemo(mPtr, morceau[ix].rey, morceau[ix].rugRel, morceau[ix].f);
+        nbrLus = nbrLus + nbr;
+    }
+    fclose(fPtr);
+    return(nbrLus);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : ecrireMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+Valeur de retour :  VRAI si la table est crite, FAUX sinon
+
+Description : Fusionne d'abord les entres que d'autres processus ont pu crire dans
+FICHIER_MEMO depuis la lecture, puis crit l'en-tte et toutes les entres dans
+FICHIER_MEMO_TEMP et renomme ce fichier en FICHIER_MEMO, comme ecrireTable() : un lecteur
+voit l'ancien fichier ou le nouveau, jamais un fichier  moiti crit, et le fichier
+temporaire est propre au processus. Le fichier n'est pas verrouill : si deux processus
+crivent en mme temps, le dernier renommage l'emporte et les entres que l'autre a
+ajoutes entre la fusion et le renommage sont perdues. Elles ne sont que recalcules au
+besoin, puisque chaque entre est un facteur de friction dj rsolu.
+------------------------------------------------------------------------*/
+int ecrireMemo(MEMO *mPtr)
+{
+    ENTETE_MEMO entete = {0};
+    FILE *fPtr;
+    char nomTemp[TAILLE_NOM_TEMP]; //fichier temporaire propre au processus
+    long ix;
+    int ok = VRAI; //drapeau
+
+    pthread_rwlock_wrlock(&mPtr->verrou);
+    lireMemo(mPtr);
+    entete.magique = MEMO_MAGIQUE;
+    entete.version = MEMO_VERSION;
+    entete.nbrEntrees = mPtr->nbrEntrees;
+    entete.tolAbs = mPtr->critere.tolAbs;
+    entete.tolRel = mPtr->critere.tolRel;
+    entete.iterMax = mPtr->critere.iterMax;
+
+    sprintf(nomTemp, FICHIER_MEMO_TEMP, numeroProcessus());
+    fPtr = fopen(nomTemp, "wb");
+    if(fPtr == NULL)
+        ok = FAUX;
+    else
+    {
+        ok = fwrite(&entete, sizeof(ENTETE_MEMO), 1, fPtr) == 1;
+        for(ix = 0; ix < mPtr->nbrCases && ok; ix = ix + 1) //seules les cases occupes sont crites
+            if(mPtr->cases[ix].rey != 0)
+                ok = fwrite(&mPtr->cases[ix], sizeof(ENTREE_MEMO), 1, fPtr) == 1;
+        if(fclose(fPtr) != 0)
+            ok = FAUX;
+    }
+
+#ifdef _WIN32
+    if(ok) //rename() ne remplace pas un fichier existant sous Windows
+        ok = MoveFileExA(nomTemp, FICHIER_MEMO, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    if(ok)
+        ok = rename(nomTemp, FICHIER_MEMO) == 0;
+#endif
+    if(!ok)
+        remove(nomTemp);
+    else
+        mPtr->nbrNouveaux = 0;
+    pthread_rwlock_unlock(&mPtr->verrou);
+    return(ok ? VRAI : FAUX);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : cleMemo
+Paramtres :
+    v - nombre de Reynolds ou rugosit relative
+Valeur de retour :  bits de la forme canonique de v
+
+Description : La cl de la mmosation est la paire sans dimension (rey, eps/d), quelles que
+soient la densit, la viscosit, le dbit ou le diamtre qui l'ont produite. Les
+MEMO_BITS_IGNORES derniers bits de la mantisse sont mis  zro : deux calculs de la mme
+paire qui ne diffrent que par l'arrondi (4*ro*debit/(pi*mu*d) ou ro*v*d/mu) partagent
+une entre, pour un cart relatif sur f bien infrieur au critre d'arrt.
+------------------------------------------------------------------------*/
+static inline uint64_t cleMemo(double v)
+{
+    uint64_t bits;
+
+    memcpy(&bits, &v, sizeof(bits));
+    return(bits & ~(((uint64_t)1 << MEMO_BITS_IGNORES) - 1));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : caseMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+    rey - nombre de Reynolds canonique
+    rugRel - rugosit relative canonique
+Valeur de retour :  indice de la case de la paire, ou de la case vide o la placer
+
+Description : Mlange les bits des deux cls et sonde linairement  partir de la case
+obtenue. La table n'tant jamais pleine  plus de moiti, une case vide est toujours trouve.
+------------------------------------------------------------------------*/
+static inline long caseMemo(MEMO *mPtr, double rey, double rugRel)
+{
+    uint64_t h; //valeur de hachage
+    long ix;
+
+    h = cleMemo(rey)*0x9E3779B97F4A7C15ULL ^ cleMemo(rugRel);
+    h = (h ^ (h >> 32))*0xD6E8FEB86659FD93ULL;
+    h = h ^ (h >> 32);
+    ix = (long)(h & (uint64_t)(mPtr->nbrCases - 1));
+    while(mPtr->cases[ix].rey != 0 && (mPtr->cases[ix].rey != rey || mPtr->cases[ix].rugRel != rugRel))
+        ix = (ix + 1) & (mPtr->nbrCases - 1);
+    return(ix);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : chercherMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+    critPtr - critre d'arrt de la mthode appelante
+Valeur de retour :  facteur de friction connu, ou 0 si la paire n'est pas dans la table
+
+Description : Cherche la forme canonique de (rey, eps/d). Plusieurs fils peuvent chercher en
+mme temps; les compteurs sont incrments de faon atomique. La table n'est consulte que
+si ses entres ont t calcules avec le mme critre d'arrt. La table doit tre ouverte
+(voir choixMemo()).
+------------------------------------------------------------------------*/
+double chercherMemo(MEMO *mPtr, double rey, double rugRel, const CRITERE *critPtr)
+{
+    double f = 0; //facteur de friction trouv
+    uint64_t bits; //forme canonique
+    long ix;
+
+    if(!memeCritere(&mPtr->critere, critPtr))
+        return(0);
+    bits = cleMemo(rey);
+    memcpy(&rey, &bits, sizeof(bits));
+    bits = cleMemo(rugRel);
+    memcpy(&rugRel, &bits, sizeof(bits));
+
+    pthread_rwlock_rdlock(&mPtr->verrou);
+    ix = caseMemo(mPtr, rey, rugRel);
+    if(mPtr->cases[ix].rey != 0)
+        f = mPtr->cases[ix].f;
+    pthread_rwlock_unlock(&mPtr->verrou);
+
+    if(f > 0)
+        __atomic_fetch_add(&mPtr->nbrTrouves, 1, __ATOMIC_RELAXED);
+    else
+        __atomic_fetch_add(&mPtr->nbrManques, 1, __ATOMIC_RELAXED);
+    return(f);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : insererMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+    f - facteur de friction calcul
+    critPtr - critre d'arrt avec lequel f a t calcul
+Valeur de retour :  void
+
+Description : Ajoute la forme canonique de (rey, eps/d) et f  la table, avec l'accs exclusif.
+------------------------------------------------------------------------*/
+void insererMemo(MEMO *mPtr, double rey, double rugRel, double f, const CRITERE *critPtr)
+{
+    uint64_t bits; //forme canonique
+
+    if(!memeCritere(&mPtr->critere, critPtr))
+        return;
+    bits = cleMemo(rey);
+    memcpy(&rey, &bits, sizeof(bits));
+    bits = cleMemo(rugRel);
+    memcpy(&rugRel, &bits, sizeof(bits));
+
+    pthread_rwlock_wrlock(&mPtr->verrou);
+    if(placerMemo(mPtr, rey, rugRel, f) == VRAI)
+        mPtr->nbrNouveaux = mPtr->nbrNouveaux + 1;
+    pthread_rwlock_unlock(&mPtr->verrou);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : placerMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+    rey - nombre de Reynolds canonique
+    rugRel - rugosit relative canonique
+    f - facteur de friction
+Valeur de retour :  VRAI si une entre est ajoute, FAUX si elle existait ou si la table est pleine
+
+Description : Place une entre dans la table, qui est agrandie au besoin par agrandirMemo()
+pour rester au plus  moiti pleine. Au-del de MEMO_CASES_MAX cases, les nouvelles paires
+ne sont plus conserves. L'appelant doit avoir l'accs exclusif  la table.
+------------------------------------------------------------------------*/
+int placerMemo(MEMO *mPtr, double rey, double rugRel, double f)
+{
+    long ix;
+
+    if(!(rey > 0 && f > 0)) //une case vide a rey = 0
+        return(FAUX);
+    if(2*(mPtr->nbrEntrees + 1) > mPtr->nbrCases && agrandirMemo(mPtr) == FAUX)
+        return(FAUX);
+
+    ix = caseMemo(mPtr, rey, rugRel);
+    if(mPtr->cases[ix].rey != 0) //dj connue
+        return(FAUX);
+    mPtr->cases[ix].rey = rey;
+    mPtr->cases[ix].rugRel = rugRel;
+    mPtr->cases[ix].f = f;
+    mPtr->nbrEntrees = mPtr->nbrEntrees + 1;
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : agrandirMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+Valeur de retour :  VRAI si la table est agrandie, FAUX si elle a atteint MEMO_CASES_MAX ou si la mmoire manque
+
+Description : Double le nombre de cases et replace toutes les entres.
+------------------------------------------------------------------------*/
+int agrandirMemo(MEMO *mPtr)
+{
+    ENTREE_MEMO *anciennes = mPtr->cases; //cases avant l'agrandissement
+    long nbrAnciennes = mPtr->nbrCases;
+    long ix;
+
+    if(nbrAnciennes >= MEMO_CASES_MAX)
+        return(FAUX);
+    mPtr->cases = calloc(2*nbrAnciennes, sizeof(ENTREE_MEMO));
+    if(mPtr->cases == NULL)
+    {
+        mPtr->cases = anciennes;
+        return(FAUX);
+    }
+    mPtr->nbrCases = 2*nbrAnciennes;
+    for(ix = 0; ix < nbrAnciennes; ix = ix + 1)
+        if(anciennes[ix].rey != 0)
+            mPtr->cases[caseMemo(mPtr, anciennes[ix].rey, anciennes[ix].rugRel)] = anciennes[ix];
+    free(anciennes);
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : memeCritere
+Paramtres :
+    aPtr, bPtr - critres d'arrt  comparer
+Valeur de retour :  VRAI si les deux critres sont identiques, FAUX sinon
+------------------------------------------------------------------------*/
+int memeCritere(const CRITERE *aPtr, const CRITERE *bPtr)
+{
+    return(aPtr->tolAbs == bPtr->tolAbs && aPtr->tolRel == bPtr->tolRel && aPtr->iterMax == bPtr->iterMax);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : libererMemo
+Paramtres :
+    mPtr - pointeur rfrant  la structure MEMO
+Valeur de retour :  void
+
+Description : Libre la table de la mmosation (FICHIER_MEMO est crit par ecrireMemo()).
+------------------------------------------------------------------------*/
+void libererMemo(MEMO *mPtr)
+{
+    if(mPtr->cases == NULL)
+        return;
+    free(mPtr->cases);
+    mPtr->cases = NULL;
+    pthread_rwlock_destroy(&mPtr->verrou);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : preparerGrille
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  VRAI si la grille convient aux donnes, FAUX sinon
+
+Description : Cette fonction ajuste les donnes  la grille choisie avant l'allocation des
+tableaux. Avec la grille gomtrique, le nombre de diamtres devient le nombre de termes
+dmin*raison^k qui ne dpassent pas dmax. Avec une liste, dmin, dmax et le nombre de
+diamtres sont ceux de la liste, mme pour des donnes importes du fichier, et le
+nombre de Reynolds est recalcul par calculerRey() pour le nouveau dmax.
+------------------------------------------------------------------------*/
+int preparerGrille(DONNEES *dPtr, OPTIONS *optPtr)
+{
+    double nbr; //nombre de diamtres de la grille gomtrique
+
+    if(optPtr->grille == GRILLE_GEOMETRIQUE)
+    {
+        nbr = floor(log(dPtr->dmax/dPtr->dmin)/log(optPtr->raison) + 1E-9) + 1;
+        if(!verifieNbrPoints(nbr))
+            return(FAUX);
+        dPtr->nbrPoints = (int)nbr;
+    }
+    else if(optPtr->grille == GRILLE_LISTE)
+    {
+        dPtr->dmin = optPtr->listetbl[0];
+        dPtr->dmax = optPtr->listetbl[optPtr->nbrListe - 1];
+        dPtr->nbrPoints = optPtr->nbrListe;
+        if(!calculerRey(dPtr))
+            return(FAUX);
+    }
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : remplirDiametres
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    nbr - nombre de diamtres  placer au dbut de dPtr->dtbl
+Valeur de retour :  void
+
+Description : Remplit dPtr->dtbl selon la grille choisie. La grille logarithmique place
+nbr diamtres  pas constant en log(d), de sorte que chaque dcade reoit le mme nombre
+de points; les extrmits valent exactement dmin et dmax. La grille gomtrique
+multiplie dmin par la raison  chaque point et la liste est recopie telle quelle.
+------------------------------------------------------------------------*/
+void remplirDiametres(DONNEES *dPtr, OPTIONS *optPtr, int nbr)
+{
+    int ix;
+
+    for(ix = 0; ix < nbr; ix = ix + 1)
+        dPtr->dtbl[ix] = diametreGrille(dPtr, optPtr, ix, nbr);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : diametreGrille
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    ix - indice du diamtre
+    nbr - nombre de diamtres de la grille
+Valeur de retour :  diamtre d'indice ix de la grille choisie (voir remplirDiametres())
+
+Description : Calcule un seul diamtre de la grille, sans tableau, pour le balayage en flux.
+------------------------------------------------------------------------*/
+double diametreGrille(DONNEES *dPtr, OPTIONS *optPtr, int ix, int nbr)
+{
+    double d;
+
+    if(optPtr->grille == GRILLE_LOG)
+        d = (ix == nbr - 1) ? dPtr->dmax : dPtr->dmin*exp(log(dPtr->dmax/dPtr->dmin)*ix/(nbr - 1));
+    else if(optPtr->grille == GRILLE_GEOMETRIQUE)
+        d = dPtr->dmin*pow(optPtr->raison, ix);
+    else if(optPtr->grille == GRILLE_LISTE)
+        d = optPtr->listetbl[ix];
+    else
+        d = dPtr->dmin + (dPtr->dmax - dPtr->dmin)/(nbr - 1)*ix;
+    return(d);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : balayageFlux
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    puits - fonction qui reoit chaque morceau de rsultats, ou NULL
+    contexte - pointeur pass tel quel au puits (fichier, rducteur, ...)
+    totalEvalPtr - pointeur o accumuler le nombre d'valuations de Colebrook
+Valeur de retour :  0 si un point n'a pas de racine, ou -1 si tous les points existent
+
+Description : Balaye les dPtr->nbrPoints diamtres de la grille sans garder les rsultats.
+Les diamtres sont calculs par morceaux de TAILLE_MORCEAU avec diametreGrille(), rsolus
+par resoudreIntervalle() dans des tampons de taille fixe, puis envoys au puits dans
+l'ordre. La mmoire utilise ne dpend donc pas du nombre de diamtres. Le minimum et le
+maximum de f sont tenus au fil du calcul dans optPtr->resPtr, avec au plus
+NBR_POINTS_TRACE + 1 points galement rpartis (et le dernier) gards dans dPtr->dtbl et
+dPtr->ftbl pour le graphique. Le suivi et les sensibilits, qui demandent un tableau par
+point, ne sont pas faits en flux. Si un point n'a pas de racine, le balayage s'arrte et
+ce point est plac au dbut de dPtr->dtbl et dPtr->ftbl.
+------------------------------------------------------------------------*/
+int balayageFlux(DONNEES *dPtr, OPTIONS *optPtr, PUITS puits, void *contexte, long *totalEvalPtr)
+{
+    double dMorceau[TAILLE_MORCEAU], fMorceau[TAILLE_MORCEAU]; //tampons d'un morceau
+    DONNEES morceau = *dPtr; //donnes du morceau courant
+    OPTIONS options = *optPtr; //options du morceau : sans suivi ni sensibilits
+    RESULTATS resMorceau = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0}; //nombre de Reynolds et vitesse du morceau
+    RESULTATS *resPtr = optPtr->resPtr;
+    int pas = (dPtr->nbrPoints + NBR_POINTS_TRACE - 1)/NBR_POINTS_TRACE; //un point sur pas est trac
+    int debut; //indice du premier diamtre du morceau
+    int nbr; //nombre de diamtres du morceau
+    int ix;
+    int echec = -1;
+
+    options.suivi = FAUX;
+    options.sensibilites = FAUX;
+    options.resPtr = &resMorceau;
+    morceau.dtbl = dMorceau;
+    morceau.ftbl = fMorceau;
+    dPtr->nbrPoints = NBR_POINTS_TRACE + 1; //taille des tableaux du graphique
+    if(allouerResultats(&resMorceau, TAILLE_MORCEAU, &options) == FAUX || allouerTableaux(dPtr) == FAUX)
+    {
+        dPtr->nbrPoints = morceau.nbrPoints;
+        libererResultats(&resMorceau);
+        return(IMPOSSIBLE);
+    }
+    dPtr->nbrPoints = morceau.nbrPoints;
+
+    resPtr->nbrTraces = 0;
+    resPtr->fMin = HUGE_VAL;
+    resPtr->fMax = -HUGE_VAL;
+    for(debut = 0; debut < dPtr->nbrPoints && echec == -1; debut = debut + nbr)
+    {
+        nbr = dPtr->nbrPoints - debut;
+        if(nbr > TAILLE_MORCEAU)
+            nbr = TAILLE_MORCEAU;
+        for(ix = 0; ix < nbr; ix = ix + 1)
+            dMorceau[ix] = diametreGrille(dPtr, optPtr, debut + ix, dPtr->nbrPoints);
+
+        echec = resoudreIntervalle(&morceau, &options, 0, nbr, totalEvalPtr);
+        if(echec >= 0) //garde le point fautif pour le message d'erreur
+        {
+            dPtr->dtbl[0] = dMorceau[echec];
+            dPtr->ftbl[0] = fMorceau[echec];
+            echec = 0;
+        }
+        else
+        {
+            if(puits != NULL)
+                puits(dMorceau, fMorceau, nbr, contexte);
+            for(ix = 0; ix < nbr; ix = ix + 1)
+            {
+                if(fMorceau[ix] < resPtr->fMin)
+                    resPtr->fMin = fMorceau[ix];
+                if(fMorceau[ix] > resPtr->fMax)
+                    resPtr->fMax = fMorceau[ix];
+                if((debut + ix) % pas == 0 || debut + ix == dPtr->nbrPoints - 1)
+                {
+                    dPtr->dtbl[resPtr->nbrTraces] = dMorceau[ix];
+                    dPtr->ftbl[resPtr->nbrTraces] = fMorceau[ix];
+                    resPtr->nbrTraces = resPtr->nbrTraces + 1;
+                }
+            }
+        }
+    }
+
+    if(echec >= 0)
+        resPtr->nbrTraces = 0;
+    libererResultats(&resMorceau);
+    return(echec);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : puitsTexte
+Paramtres :
+    dtbl - diamtres du morceau
+    ftbl - facteurs de friction du morceau
+    nbr - nombre de paires du morceau
+    contexte - fichier (FILE *) o crire
+Valeur de retour :  void
+
+Description : Puits du balayage en flux qui crit une paire "diamtre;f" par ligne.
+------------------------------------------------------------------------*/
+void puitsTexte(const double dtbl[], const double ftbl[], int nbr, void *contexte)
+{
+    FILE *fichierPtr = contexte;
+    int ix;
+
+    for(ix = 0; ix < nbr; ix = ix + 1)
+        fprintf(fichierPtr, "%.17g;%.17g\n", dtbl[ix], ftbl[ix]);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixFlux
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS.
+Valeur de retour :  void
+
+Description : Demande  l'utilisateur la sortie du balayage : tableaux en mmoire, ou flux
+vers un fichier, vers la sortie standard ou vers le minimum et le maximum seulement.
+------------------------------------------------------------------------*/
+void choixFlux(OPTIONS *optPtr)
+{
+    int ix;
+
+    printf("\nSortie du balayage : \n");
+    for(ix = SANS_FLUX; ix <= FLUX_REDUCTION; ix = ix + 1)
+        printf("%d) %s\n", ix, nomFlux(ix));
+    do
+    {
+        printf("Entrez un chiffre de %d \205 %d : ", SANS_FLUX, FLUX_REDUCTION);
+        fflush(stdin);
+        scanf("%d", &optPtr->flux);
+    }
+    while(optPtr->flux < SANS_FLUX || optPtr->flux > FLUX_REDUCTION);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : nomFlux
+Paramtres :
+    flux - sortie du balayage
+Valeur de retour :  nom - chane de caractres qui dcrit la sortie
+
+Description : Retourne le nom de la sortie du balayage, pour l'affichage.
+------------------------------------------------------------------------*/
+char *nomFlux(int flux)
+{
+    char *nom;
+
+    if(flux == FLUX_FICHIER)
+        nom = "flux vers le fichier " FICHIER_FLUX;
+    else if(flux == FLUX_SORTIE)
+        nom = "flux vers la sortie standard";
+    else if(flux == FLUX_REDUCTION)
+        nom = "flux, minimum et maximum seulement";
+    else
+        nom = "tableaux en m\202moire";
+    return(nom);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : reyPoint
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    d - diamtre
+Valeur de retour :  nombre de Reynolds au diamtre d
+
+Description :  dbit constant, v = 4*debit/(pi*d^2), donc rey = ro*v*d/mu = 4*ro*debit/(pi*mu*d).
+Si le nombre de Reynolds n'est pas calcul  chaque diamtre, retourne celui de calculerRey(),
+obtenu au diamtre maximal.
+------------------------------------------------------------------------*/
+static inline double reyPoint(DONNEES *dPtr, OPTIONS *optPtr, double d)
+{
+    if(optPtr->reyVariable == VRAI)
+        return(4*dPtr->ro*dPtr->debit/(M_PI*dPtr->mu*d));
+    return(dPtr->rey);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : resoudreIntervalle
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    debut - indice du premier diamtre  calculer
+    fin - indice qui suit le dernier diamtre  calculer
+    totalEvalPtr - pointeur o accumuler le nombre d'valuations de Colebrook
+Valeur de retour :  indice du premier point sans racine, ou -1 si tous les points existent
+
+Description : Cette fonction calcule les facteurs de friction des diamtres d'indices
+debut  fin-1 et les place dans dPtr->ftbl. Les valeurs sont calcules  l'aide de la
+fonction calculFriction(), ou par blocs avec le noyau vectoriel choisi (voir
+choisirNoyau()) lorsque la mthode de Newton est choisie, ou avec calculNewtonBlocFloat()
+si une prcision simple est choisie et qu'aucune option n'impose le calcul scalaire (voir
+precisionNewton()). Avec le suivi, tous les points sont calculs par
+calculFriction() et le nombre d'valuations et le rsidu final de chaque point sont
+conservs dans optPtr->resPtr. Avec les sensibilits, df/dd, df/drey et df/deps sont
+calcules dans la mme boucle  partir de chaque facteur de friction trouv (voir
+calculSensibilites()), sans autre rsolution. Le nombre de Reynolds de chaque point est
+donn par reyPoint() : il varie avec le diamtre, ou reste celui du diamtre maximal; il
+est conserv, avec la vitesse, dans optPtr->resPtr. Avec l'option de continuation, chaque
+point (ou bloc) part de la solution du point prcdent de l'intervalle. Si les facteurs
+de friction sont repris du balayage prcdent (optPtr->anciennetbl, voir comparerCache()),
+ils sont copis sans rsolution et seuls les rsultats par point sont refaits. Avec la
+mmosation, tous les points passent par calculFriction(), qui la consulte. Le calcul
+s'arrte au premier point sans racine.
+------------------------------------------------------------------------*/
+int resoudreIntervalle(DONNEES *dPtr, OPTIONS *optPtr, int debut, int fin, long *totalEvalPtr)
+{
+    int ix;
+    int jx;
+    int finBloc = debut; //indice qui suit le dernier point calcul par le noyau vectoriel
+    int echec = -1; //indice du premier point sans racine
+    double reyBloc[LARGEUR_VECT], rugBloc[LARGEUR_VECT]; //entres du noyau vectoriel
+
+    double reyFloat[LARGEUR_VECT_FLOAT], rugFloat[LARGEUR_VECT_FLOAT]; //entres du noyau en simple prcision
+    double gPrime; //drive de Colebrook (non utilise)
+    double rey; //nombre de Reynolds du point courant
+    RESULTATS *resPtr = optPtr->resPtr;
+
+    for(ix = debut; ix < fin && echec == -1; ix = ix +1)
+    {
+        rey = reyPoint(dPtr, optPtr, dPtr->dtbl[ix]);
+
+        //en simple prcision, les blocs complets de LARGEUR_VECT_FLOAT diamtres passent par le noyau float
+        if(optPtr->methode == NEWTON && precisionNewton(optPtr) != PRECISION_DOUBLE && optPtr->anciennetbl == NULL
+           && ix == finBloc && ix + LARGEUR_VECT_FLOAT <= fin)
+        {
+            for(jx = 0; jx < LARGEUR_VECT_FLOAT; jx = jx + 1)
+            {
+                reyFloat[jx] = reyPoint(dPtr, optPtr, dPtr->dtbl[ix+jx]);
+                rugFloat[jx] = dPtr->eps/dPtr->dtbl[ix+jx];
+            }
+            *totalEvalPtr = *totalEvalPtr + calculNewtonBlocFloat(reyFloat, rugFloat, &dPtr->ftbl[ix], optPtr->precision == PRECISION_RAFFINEE);
+            finBloc = ix + LARGEUR_VECT_FLOAT;
+        }
+
+        //avec Newton, les blocs complets de LARGEUR_VECT diamtres passent par le noyau vectoriel
+        if(optPtr->methode == NEWTON && optPtr->precision == PRECISION_DOUBLE && optPtr->noyauNewton != NULL && optPtr->suivi == FAUX
+           && optPtr->anciennetbl == NULL && optPtr->memoisation == FAUX && ix == finBloc && ix + LARGEUR_VECT <= fin)
+        {
+            for(jx = 0; jx < LARGEUR_VECT; jx = jx + 1)
+            {
+                reyBloc[jx] = reyPoint(dPtr, optPtr, dPtr->dtbl[ix+jx]);
+                rugBloc[jx] = dPtr->eps/dPtr->dtbl[ix+jx];
+            }
+            optPtr->graine = (optPtr->continuation == VRAI && ix > debut) ? dPtr->ftbl[ix-1] : 0;
+            *totalEvalPtr = *totalEvalPtr + optPtr->noyauNewton(reyBloc, rugBloc, &dPtr->ftbl[ix], optPtr->graine, &optPtr->critere);
+            finBloc = ix + LARGEUR_VECT;
+        }
+
+        if(optPtr->anciennetbl != NULL) //aucune entre de f n'a chang
+        {
+            dPtr->ftbl[ix] = optPtr->anciennetbl[ix];
+            optPtr->nbrEvaluations = 0;
+        }
+        else if(ix >= finBloc || dPtr->ftbl[ix] == IMPOSSIBLE) //point non calcul ou rejet par le noyau vectoriel
+        {
+            //avec la continuation, part de la solution du point prcdent
+            optPtr->graine = (optPtr->continuation == VRAI && ix > debut) ? dPtr->ftbl[ix-1] : 0;
+            dPtr->ftbl[ix] = calculFriction(rey, dPtr->eps/dPtr->dtbl[ix], optPtr);
+            *totalEvalPtr = *totalEvalPtr + optPtr->nbrEvaluations;
+        }
+
+        if(optPtr->suivi == VRAI) //tous les points passent par calculFriction
+        {
+            resPtr->evaltbl[ix] = (int)optPtr->nbrEvaluations; //un seul point : au plus quelques fois iterMax
+            if(dPtr->ftbl[ix] > 0)
+                resPtr->residutbl[ix] = fabs(calculColebrookX(1/sqrt(dPtr->ftbl[ix]), rey, dPtr->eps/dPtr->dtbl[ix], &gPrime));
+            else
+                resPtr->residutbl[ix] = NAN;
+        }
+        if(optPtr->reyVariable == VRAI)
+        {
+            resPtr->reytbl[ix] = rey;
+            resPtr->vittbl[ix] = 4*dPtr->debit/(M_PI*dPtr->dtbl[ix]*dPtr->dtbl[ix]);
+        }
+
+        if(dPtr->ftbl[ix] < 0) //vrifie si facteur de friction existe
+            echec = ix;
+        else if(optPtr->sensibilites == VRAI)
+        {
+            calculSensibilites(dPtr->ftbl[ix], rey, dPtr->eps, dPtr->dtbl[ix],
+                               &resPtr->dfdDtbl[ix], &resPtr->dfdReytbl[ix], &resPtr->dfdEpstbl[ix]);
+            if(optPtr->reyVariable == VRAI) //rey = 4*ro*debit/(pi*mu*d), donc drey/dd = -rey/d
+                resPtr->dfdDtbl[ix] = resPtr->dfdDtbl[ix] - resPtr->dfdReytbl[ix]*rey/dPtr->dtbl[ix];
+        }
+    }
+    return(echec);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : echantillonnageAdaptatif
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    totalEvalPtr - pointeur o accumuler le nombre d'valuations de Colebrook
+Valeur de retour :  indice du premier point sans racine, ou -1 si tous les points existent
+
+Description : Cette fonction rpartit au plus dPtr->nbrPoints diamtres selon la courbure
+du facteur de friction. Elle part de POINTS_INITIAUX diamtres rpartis selon la grille
+linaire ou logarithmique (voir remplirDiametres()), puis,
+ chaque passe, estime l'erreur de l'interpolation linaire de chaque intervalle entre
+deux voisins (voir erreurInterpolation()) et ajoute le milieu des intervalles dont
+l'erreur relative dpasse optPtr->tolEchantillon. Si le nombre de points restant ne
+suffit pas, seuls les intervalles de plus grande erreur sont coups. Les milieux d'une
+passe sont placs, en ordre croissant,  la fin des tableaux et calculs ensemble par
+resoudreIntervalle() (noyaux vectoriels, suivi et sensibilits compris), puis insrs
+ leur place. Seuls les points conservs sont calculs.  la fin, dPtr->nbrPoints
+devient le nombre de diamtres calculs et les tableaux restent tris. Si les tableaux
+de travail ne peuvent pas tre allous, les dPtr->nbrPoints diamtres sont calculs
+selon la grille, sans raffinement.
+------------------------------------------------------------------------*/
+int echantillonnageAdaptatif(DONNEES *dPtr, OPTIONS *optPtr, long *totalEvalPtr)
+{
+    int budget = dPtr->nbrPoints; //nombre maximal de diamtres (taille des tableaux)
+    int nbr = POINTS_INITIAUX; //nombre de diamtres tris et calculs
+    int nbrNouv; //nombre de milieux ajouts  la passe
+    int ix;
+    int echec; //indice du premier point sans racine, ou -1
+    int passe = 0; //nombre de passes de raffinement
+    double seuil; //erreur relative au-del de laquelle un intervalle est coup
+    double erreurMax; //plus grande erreur estime  la dernire passe
+    double *erreurs = reallouerTableau(NULL, budget, sizeof(double)); //erreur estime de chaque intervalle
+    double *tri = reallouerTableau(NULL, budget, sizeof(double)); //erreurs tries en ordre dcroissant
+    double *tampon = reallouerTableau(NULL, budget, sizeof(double)); //milieux en attente d'insertion
+    int *tamponEntier = reallouerTableau(NULL, budget, sizeof(int));
+    int *apres = reallouerTableau(NULL, budget, sizeof(int)); //indice du point qui prcde chaque milieu
+    RESULTATS *resPtr = optPtr->resPtr;
+
+    if(erreurs == NULL || tri == NULL || tampon == NULL || tamponEntier == NULL || apres == NULL)
+    {
+        printf("\n - ERREUR! M\202moire insuffisante pour l'\202chantillonnage adaptatif, \202chantillonnage uniforme.");
+        remplirDiametres(dPtr, optPtr, budget);
+        echec = resoudreIntervalle(dPtr, optPtr, 0, budget, totalEvalPtr);
+        free(erreurs);
+        free(tri);
+        free(tampon);
+        free(tamponEntier);
+        free(apres);
+        return(echec);
+    }
+
+    //dpart grossier selon la grille
+    remplirDiametres(dPtr, optPtr, nbr);
+    echec = resoudreIntervalle(dPtr, optPtr, 0, nbr, totalEvalPtr);
+
+    do
+    {
+        //estime l'erreur de chaque intervalle et compte ceux  couper
+        nbrNouv = 0;
+        erreurMax = 0;
+        for(ix = 0; ix < nbr - 1 && echec == -1; ix = ix + 1)
+        {
+            erreurs[ix] = erreurInterpolation(dPtr->dtbl, dPtr->ftbl, nbr, ix);
+            if(erreurs[ix] > erreurMax)
+                erreurMax = erreurs[ix];
+            if(erreurs[ix] > optPtr->tolEchantillon)
+            {
+                tri[nbrNouv] = erreurs[ix];
+                nbrNouv = nbrNouv + 1;
+            }
+        }
+
+        //budget insuffisant : ne coupe que les budget - nbr intervalles de plus grande erreur
+        seuil = optPtr->tolEchantillon;
+        if(nbrNouv > budget - nbr)
+        {
+            qsort(tri, nbrNouv, sizeof(double), comparerDecroissant);
+            seuil = tri[budget - nbr];
+        }
+
+        //place les milieux  la fin des tableaux, en ordre croissant
+        nbrNouv = 0;
+        for(ix = 0; ix < nbr - 1 && nbr + nbrNouv < budget && echec == -1; ix = ix + 1)
+        {
+            if(erreurs[ix] > seuil)
+            {
+                dPtr->dtbl[nbr + nbrNouv] = 0.5*(dPtr->dtbl[ix] + dPtr->dtbl[ix+1]);
+                apres[nbrNouv] = ix;
+                nbrNouv = nbrNouv + 1;
+            }
+        }
+
+        if(nbrNouv > 0)
+        {
+            echec = resoudreIntervalle(dPtr, optPtr, nbr, nbr + nbrNouv, totalEvalPtr);
+            if(echec == -1)
+            {
+                insererMilieux(dPtr->dtbl, tampon, nbr, nbrNouv, apres);
+                insererMilieux(dPtr->ftbl, tampon, nbr, nbrNouv, apres);
+                if(optPtr->suivi == VRAI)
+                {
+                    insererMilieuxEntier(resPtr->evaltbl, tamponEntier, nbr, nbrNouv, apres);
+                    insererMilieux(resPtr->residutbl, tampon, nbr, nbrNouv, apres);
+                }
+                if(optPtr->sensibilites == VRAI)
+                {
+                    insererMilieux(resPtr->dfdDtbl, tampon, nbr, nbrNouv, apres);
+                    insererMilieux(resPtr->dfdReytbl, tampon, nbr, nbrNouv, apres);
+                    insererMilieux(resPtr->dfdEpstbl, tampon, nbr, nbrNouv, apres);
+                }
+                if(optPtr->reyVariable == VRAI)
+                {
+                    insererMilieux(resPtr->reytbl, tampon, nbr, nbrNouv, apres);
+                    insererMilieux(resPtr->vittbl, tampon, nbr, nbrNouv, apres);
+                }
+                nbr = nbr + nbrNouv;
+                passe = passe + 1;
+            }
+        }
+    }
+    while(nbrNouv > 0 && echec == -1);
+
+    if(echec == -1)
+    {
+        printf("\n\220chantillonnage adaptatif : %d diam\212tres sur un maximum de %d, %d passes, erreur d'interpolation estim\202e %.2e.",
+               nbr, budget, passe, erreurMax);
+        dPtr->nbrPoints = nbr;
+    }
+
+    free(erreurs);
+    free(tri);
+    free(tampon);
+    free(tamponEntier);
+    free(apres);
+    return(echec);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : erreurInterpolation
+Paramtres :
+    dtbl - diamtres tris
+    ftbl - facteurs de friction correspondants
+    nbr - nombre de points
+    ix - indice du premier point de l'intervalle [dtbl[ix], dtbl[ix+1]]
+Valeur de retour :  erreur relative estime de l'interpolation linaire sur l'intervalle
+
+Description : L'erreur maximale de l'interpolation linaire sur un intervalle de largeur h
+est |f''|*h^2/8. La drive seconde est estime par les diffrences divises
+f''/2 = f[a, b, c] sur les triplets de voisins qui contiennent l'intervalle ( gauche et
+ droite); la plus grande des deux estimations est retenue, sans nouveau calcul de f.
+------------------------------------------------------------------------*/
+double erreurInterpolation(const double dtbl[], const double ftbl[], int nbr, int ix)
+{
+    double h = dtbl[ix+1] - dtbl[ix];
+    double pente = (ftbl[ix+1] - ftbl[ix])/h; //pente de l'intervalle
+    double courbure = 0; //plus grande estimation de |f''|/2
+    double diff; //diffrence divise d'ordre 2
+
+    if(ix > 0)
+    {
+        diff = (pente - (ftbl[ix] - ftbl[ix-1])/(dtbl[ix] - dtbl[ix-1]))/(dtbl[ix+1] - dtbl[ix-1]);
+        courbure = fabs(diff);
+    }
+    if(ix + 2 < nbr)
+    {
+        diff = ((ftbl[ix+2] - ftbl[ix+1])/(dtbl[ix+2] - dtbl[ix+1]) - pente)/(dtbl[ix+2] - dtbl[ix]);
+        if(fabs(diff) > courbure)
+            courbure = fabs(diff);
+    }
+
+    return(courbure*h*h/4/fmin(ftbl[ix], ftbl[ix+1]));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : insererMilieux
+Paramtres :
+    tbl - tableau tri de nbr valeurs, suivi des nbrNouv valeurs  insrer
+    tampon - tableau de travail d'au moins nbrNouv valeurs
+    nbr - nombre de valeurs dj tries
+    nbrNouv - nombre de valeurs  insrer
+    apres - indice, en ordre croissant, de la valeur qui prcde chaque nouvelle valeur
+Valeur de retour :  void
+
+Description : Insre sur place chaque nouvelle valeur tbl[nbr+k] juste aprs tbl[apres[k]],
+en parcourant le tableau de la fin vers le dbut.
+------------------------------------------------------------------------*/
+void insererMilieux(double tbl[], double tampon[], int nbr, int nbrNouv, const int apres[])
+{
+    int src;
+    int dest = nbr + nbrNouv - 1; //prochaine case  remplir
+    int k = nbrNouv - 1; //prochaine nouvelle valeur  insrer
+
+    memcpy(tampon, &tbl[nbr], nbrNouv*sizeof(double));
+    for(src = nbr - 1; src >= 0 && k >= 0; src = src - 1)
+    {
+        if(apres[k] == src)
+        {
+            tbl[dest] = tampon[k];
+            dest = dest - 1;
+            k = k - 1;
+        }
+        tbl[dest] = tbl[src];
+        dest = dest - 1;
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : insererMilieuxEntier
+Paramtres : (voir insererMilieux())
+Valeur de retour :  void
+
+Description : Version de insererMilieux() pour un tableau d'entiers.
+------------------------------------------------------------------------*/
+void insererMilieuxEntier(int tbl[], int tampon[], int nbr, int nbrNouv, const int apres[])
+{
+    int src;
+    int dest = nbr + nbrNouv - 1; //prochaine case  remplir
+    int k = nbrNouv - 1; //prochaine nouvelle valeur  insrer
+
+    memcpy(tampon, &tbl[nbr], nbrNouv*sizeof(int));
+    for(src = nbr - 1; src >= 0 && k >= 0; src = src - 1)
+    {
+        if(apres[k] == src)
+        {
+            tbl[dest] = tampon[k];
+            dest = dest - 1;
+            k = k - 1;
+        }
+        tbl[dest] = tbl[src];
+        dest = dest - 1;
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : comparerDecroissant
+Paramtres :
+    aPtr, bPtr - pointeurs vers deux double
+Valeur de retour :  ngatif, 0 ou positif pour trier en ordre dcroissant avec qsort()
+
+Description : Fonction de comparaison pour qsort().
+------------------------------------------------------------------------*/
+int comparerDecroissant(const void *aPtr, const void *bPtr)
+{
+    double a = *(const double *)aPtr;
+    double b = *(const double *)bPtr;
+
+    return((a < b) - (a > b));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : comparerCroissant
+Paramtres :
+    aPtr, bPtr - pointeurs vers deux double
+Valeur de retour :  ngatif, 0 ou positif pour trier en ordre croissant avec qsort()
+
+Description : Fonction de comparaison pour qsort().
+------------------------------------------------------------------------*/
+int comparerCroissant(const void *aPtr, const void *bPtr)
+{
+    return(comparerDecroissant(bPtr, aPtr));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : balayageParallele
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+    totalEvalPtr - pointeur o accumuler le nombre d'valuations de Colebrook
+Valeur de retour :  indice du premier point sans racine, ou -1 si tous les points existent
+
+Description : Cette fonction calcule les diamtres en parallle avec plusieurs fils
+d'excution, selon l'ordonnancement choisi :
+    STATIQUE - les diamtres sont partags en intervalles contigus, un par fil.
+    VOL_TACHES - les diamtres sont dcoups en tranches de TAILLE_TRANCHE, rparties
+                 en parts gales dans la file de chaque fil. Un fil dont la file est vide
+                 vole des tranches  la fin de la file des autres (voir obtenirTranche()),
+                 ce qui quilibre la charge lorsque le cot des points est ingal.
+Les frontires des intervalles et des tranches sont des multiples du nombre de doubles
+par ligne de cache, sans dpasser dPtr->nbrPoints (voir aligneIndice()) : si ftbl commence
+une ligne, deux fils n'crivent jamais dans la mme ligne. Chaque fil
+garde une copie prive des options. Le premier point sans racine est le plus petit
+indice d'chec parmi les fils, comme pour le calcul squentiel.
+------------------------------------------------------------------------*/
+int balayageParallele(DONNEES *dPtr, OPTIONS *optPtr, long *totalEvalPtr)
+{
+    pthread_t fils[NBR_FILS_MAX]; //fils d'excution
+    TRAVAIL travail[NBR_FILS_MAX]; //travail confi  chaque fil
+    DEQUE deques[NBR_FILS_MAX]; //files de tranches (VOL_TACHES)
+    int *bornes = NULL; //dbut de chaque tranche (VOL_TACHES)
+    int nbrTranches = 0; //nombre de tranches (VOL_TACHES)
+    void *(*fonction)(void *); //fonction excute par chaque fil
+    int nbrFils; //nombre de fils utiliss
+    int ix;
+    int echec = -1; //indice du premier point sans racine
+
+    nbrFils = optPtr->nbrFils;
+    if(nbrFils > dPtr->nbrPoints/POINTS_MIN_PAR_FIL)
+        nbrFils = dPtr->nbrPoints/POINTS_MIN_PAR_FIL;
+
+    fonction = travailleur;
+    if(optPtr->ordonnancement == VOL_TACHES)
+    {
+        nbrTranches = (dPtr->nbrPoints + TAILLE_TRANCHE - 1)/TAILLE_TRANCHE;
+        bornes = malloc((nbrTranches + 1)*sizeof(int));
+        if(bornes != NULL) //sinon, ordonnancement statique
+        {
+            bornes[0] = 0;
+            for(ix = 1; ix < nbrTranches; ix = ix + 1)
+                bornes[ix] = aligneIndice(ix*TAILLE_TRANCHE, dPtr->nbrPoints);
+            bornes[nbrTranches] = dPtr->nbrPoints;
+            fonction = travailleurVol;
+        }
+    }
+
+    for(ix = 0; ix < nbrFils; ix = ix + 1)
+    {
+        travail[ix].dPtr = dPtr;
+        travail[ix].options = *optPtr;
+        travail[ix].debut = (ix == 0) ? 0 : travail[ix-1].fin;
+        travail[ix].fin = (ix == nbrFils - 1) ? dPtr->nbrPoints
+                          : aligneIndice((int)((long long)dPtr->nbrPoints*(ix + 1)/nbrFils), dPtr->nbrPoints);
+        travail[ix].id = ix;
+        travail[ix].nbrFils = nbrFils;
+        travail[ix].deques = deques;
+        travail[ix].bornes = bornes;
+        travail[ix].echec = -1;
+        travail[ix].totalEval = 0;
+        travail[ix].nbrPointsCalcules = 0;
+        travail[ix].nbrVols = 0;
+
+        //part gale de tranches dans la file de chaque fil
+        pthread_mutex_init(&deques[ix].verrou, NULL);
+        deques[ix].premiere = (int)((long long)nbrTranches*ix/nbrFils);
+        deques[ix].derniere = (int)((long long)nbrTranches*(ix + 1)/nbrFils);
+    }
+
+    //le fil principal travaille aussi pendant que les autres calculent
+    for(ix = 1; ix < nbrFils; ix = ix + 1)
+        pthread_create(&fils[ix], NULL, fonction, &travail[ix]);
+    fonction(&travail[0]);
+    for(ix = 1; ix < nbrFils; ix = ix + 1)
+        pthread_join(fils[ix], NULL);
+
+    for(ix = 0; ix < nbrFils; ix = ix + 1)
+    {
+        *totalEvalPtr = *totalEvalPtr + travail[ix].totalEval;
+        if(travail[ix].echec >= 0 && (echec == -1 || travail[ix].echec < echec))
+            echec = travail[ix].echec;
+        pthread_mutex_destroy(&deques[ix].verrou);
+    }
+    afficheStatsFils(travail, nbrFils);
+
+    free(bornes);
+    return(echec);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : travailleur
+Paramtres :
+    arg - pointeur rfrant  la structure TRAVAIL du fil
+Valeur de retour :  NULL
+
+Description : Fonction excute par chaque fil avec l'ordonnancement statique :
+calcule l'intervalle qui lui est confi.
+------------------------------------------------------------------------*/
+void *travailleur(void *arg)
+{
+    TRAVAIL *tPtr = arg;
+
+    tPtr->echec = resoudreIntervalle(tPtr->dPtr, &tPtr->options, tPtr->debut, tPtr->fin, &tPtr->totalEval);
+    tPtr->nbrPointsCalcules = tPtr->fin - tPtr->debut;
+    return(NULL);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : travailleurVol
+Paramtres :
+    arg - pointeur rfrant  la structure TRAVAIL du fil
+Valeur de retour :  NULL
+
+Description : Fonction excute par chaque fil avec le vol de tches : calcule des
+tranches, obtenues par obtenirTranche(), tant qu'il en reste dans une des files.
+------------------------------------------------------------------------*/
+void *travailleurVol(void *arg)
+{
+    TRAVAIL *tPtr = arg;
+    int tranche; //numro de la tranche  calculer
+    int echec; //premier point sans racine de la tranche
+
+    while(obtenirTranche(tPtr, &tranche) == VRAI)
+    {
+        echec = resoudreIntervalle(tPtr->dPtr, &tPtr->options, tPtr->bornes[tranche], tPtr->bornes[tranche+1], &tPtr->totalEval);
+        if(echec >= 0 && (tPtr->echec == -1 || echec < tPtr->echec))
+            tPtr->echec = echec;
+        tPtr->nbrPointsCalcules = tPtr->nbrPointsCalcules + tPtr->bornes[tranche+1] - tPtr->bornes[tranche];
+    }
+    return(NULL);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : obtenirTranche
+Paramtres :
+    tPtr - pointeur rfrant  la structure TRAVAIL du fil
+    tranchePtr - pointeur o crire le numro de la tranche obtenue
+Valeur de retour :  VRAI si une tranche a t obtenue, FAUX s'il n'en reste plus
+
+Description : Le fil prend d'abord la premire tranche de sa propre file, ce qui garde
+ses diamtres voisins ensemble. Si sa file est vide, il parcourt les files des autres
+fils et vole la dernire tranche de la premire file non vide. Comme aucune tranche
+n'est ajoute pendant le calcul, le travail est termin lorsque toutes les files sont vides.
+------------------------------------------------------------------------*/
+int obtenirTranche(TRAVAIL *tPtr, int *tranchePtr)
+{
+    DEQUE *qPtr; //file consulte
+    int ix;
+    int trouve = FAUX; //drapeau
+
+    qPtr = &tPtr->deques[tPtr->id];
+    pthread_mutex_lock(&qPtr->verrou);
+    if(qPtr->premiere < qPtr->derniere)
+    {
+        *tranchePtr = qPtr->premiere;
+        qPtr->premiere = qPtr->premiere + 1;
+        trouve = VRAI;
+    }
+    pthread_mutex_unlock(&qPtr->verrou);
+
+    for(ix = 1; ix < tPtr->nbrFils && trouve == FAUX; ix = ix + 1) //vol, en commenant par le fil suivant
+    {
+        qPtr = &tPtr->deques[(tPtr->id + ix) % tPtr->nbrFils];
+        pthread_mutex_lock(&qPtr->verrou);
+        if(qPtr->premiere < qPtr->derniere)
+        {
+            qPtr->derniere = qPtr->derniere - 1;
+            *tranchePtr = qPtr->derniere;
+            tPtr->nbrVols = tPtr->nbrVols + 1;
+            trouve = VRAI;
+        }
+        pthread_mutex_unlock(&qPtr->verrou);
+    }
+    return(trouve);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheStatsFils
+Paramtres :
+    travail - tableau des structures TRAVAIL des fils
+    nbrFils - nombre de fils
+Valeur de retour :  void
+
+Description : Affiche, pour chaque fil, le nombre de diamtres calculs et le
+nombre de tranches voles.
+------------------------------------------------------------------------*/
+void afficheStatsFils(TRAVAIL travail[], int nbrFils)
+{
+    int ix;
+
+    printf("\n%d fils d'ex\202cution :", nbrFils);
+    for(ix = 0; ix < nbrFils; ix = ix + 1)
+        printf("\n%5cFil %3d : %10d diam\212tres, %6d tranches vol\202es", ' ', ix,
+               travail[ix].nbrPointsCalcules, travail[ix].nbrVols);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : aligneIndice
+Paramtres :
+    ix - indice  aligner
+    nbr - nombre d'lments du tableau
+Valeur de retour :  premier multiple de TAILLE_LIGNE_CACHE/sizeof(double) >= ix, au plus nbr
+
+Description : Cette fonction avance l'indice jusqu'au dbut de la ligne de cache suivante,
+compte  partir du dbut du tableau, pour sparer le travail de deux fils. Le rsultat ne
+dpend pas de l'adresse du tableau et ne dpasse jamais sa fin, de sorte que les frontires
+restent croissantes et dans le tableau.
+------------------------------------------------------------------------*/
+int aligneIndice(int ix, int nbr)
+{
+    int parLigne = TAILLE_LIGNE_CACHE/sizeof(double); //nombre de doubles par ligne de cache
+
+    ix = (ix + parLigne - 1)/parLigne*parLigne;
+    if(ix > nbr)
+        ix = nbr;
+    return(ix);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : nbrProcesseurs
+Paramtres :
+    (aucun)
+Valeur de retour :  nombre de processeurs logiques de la machine (au moins 1)
+
+Description : Retourne le nombre de processeurs, utilis comme nombre de fils par dfaut.
+------------------------------------------------------------------------*/
+int nbrProcesseurs()
+{
+    long nbr; //nombre de processeurs
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    nbr = info.dwNumberOfProcessors;
+#else
+    nbr = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if(nbr < 1)
+        nbr = 1;
+    if(nbr > NBR_FILS_MAX)
+        nbr = NBR_FILS_MAX;
+    return((int)nbr);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : chrono
+Paramtres :
+    (aucun)
+Valeur de retour :  temps coul en secondes depuis une origine fixe
+
+Description : Horloge murale monotone, pour mesurer la dure des calculs.
+------------------------------------------------------------------------*/
+double chrono()
+{
+    struct timespec temps;
+
+    clock_gettime(CLOCK_MONOTONIC, &temps);
+    return(temps.tv_sec + temps.tv_nsec*1E-9);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : reallouerTableau
+Paramtres :
+    tbl - tableau  rallouer, ou NULL pour une nouvelle allocation
+    nbr - nombre d'lments
+    taille - taille d'un lment en octets
+Valeur de retour :  tableau rallou, ou NULL si la mmoire manque
+
+Description : Comme realloc(tbl, nbr*taille), mais refuse une taille qui ne tient pas
+dans size_t (32 bits sur une cible 32 bits, o NBR_POINTS_MAX doubles la dpassent) au
+lieu de laisser le produit dborder et d'allouer un bloc trop petit. En cas d'chec,
+tbl reste allou.
+------------------------------------------------------------------------*/
+void *reallouerTableau(void *tbl, int64_t nbr, size_t taille)
+{
+    if(nbr < 0 || (uint64_t)nbr > SIZE_MAX/taille)
+        return(NULL);
+    return(realloc(tbl, (size_t)nbr*taille));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : allouerTableaux
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+Valeur de retour :  VRAI si l'allocation a russi, FAUX autrement
+
+Description : Cette fonction alloue (ou ralloue) les tableaux du diamtre et du
+facteur de friction pour dPtr->nbrPoints valeurs. Affiche un message si la mmoire
+est insuffisante.
+------------------------------------------------------------------------*/
+int allouerTableaux(DONNEES *dPtr)
+{
+    double *dtbl, *ftbl; //nouveaux tableaux
+
+    dtbl = reallouerTableau(dPtr->dtbl, dPtr->nbrPoints, sizeof(double));
+    if(dtbl != NULL)
+        dPtr->dtbl = dtbl;
+    ftbl = reallouerTableau(dPtr->ftbl, dPtr->nbrPoints, sizeof(double));
+    if(ftbl != NULL)
+        dPtr->ftbl = ftbl;
+
+    if(dtbl == NULL || ftbl == NULL)
+    {
+        printf("\n - ERREUR! M\202moire insuffisante pour %d diam\212tres.\n", dPtr->nbrPoints);
+        return(FAUX);
+    }
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : libererTableaux
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+Valeur de retour :  void
+
+Description : Cette fonction libre les tableaux du diamtre et du facteur de friction.
+------------------------------------------------------------------------*/
+void libererTableaux(DONNEES *dPtr)
+{
+    free(dPtr->dtbl);
+    free(dPtr->ftbl);
+    dPtr->dtbl = NULL;
+    dPtr->ftbl = NULL;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculFriction
+Paramtres :
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  f - valeur de la racine trouve, IMPOSSIBLE ou NON_CONVERGE
+
+Description : Cette fonction trouve la valeur du facteur de friction pour le nombre
+de Reynolds et la rugosit relative donns  l'aide de la mthode choisie dans les options (bissection, Newton, omga de
+Wright, une corrlation explicite, la table prcalcule ou le substitut de Tchebychev).
+Hors du domaine de la table ou du substitut, la mthode de Newton est utilise. Le nombre
+d'valuations de Colebrook utilises est conserv dans optPtr->nbrEvaluations. Les
+mthodes itratives partent de optPtr->graine si elle est positive. Avec la mmosation,
+Newton et la bissection cherchent d'abord (rey, eps/d) dans optPtr->memoPtr, sans
+valuation si la paire est connue, et y ajoutent chaque facteur de friction calcul.
+------------------------------------------------------------------------*/
+double calculFriction(double rey, double rugRel, OPTIONS *optPtr)
+{
+    double f; //facteur de friction
+    int memo; //drapeau : la mmosation s'applique  cette mthode
+
+    memo = optPtr->memoisation == VRAI && (optPtr->methode == NEWTON || optPtr->methode == BISSECTION);
+    if(memo)
+    {
+        f = chercherMemo(optPtr->memoPtr, rey, rugRel, &optPtr->critere);
+        if(f > 0)
+        {
+            optPtr->nbrEvaluations = 0;
+            return(f);
+        }
+    }
+
+    if(optPtr->methode == NEWTON)
+        f = calculNewton(rey, rugRel, &optPtr->nbrEvaluations, optPtr->graine, &optPtr->critere);
+    else if(optPtr->methode == BISSECTION)
+        f = calculBissection(rey, rugRel, &optPtr->nbrEvaluations, optPtr->graine, &optPtr->critere);
+    else if(optPtr->methode == OMEGA_WRIGHT) //solution exacte, aucune itration
+    {
+        f = calculOmega(rey, rugRel);
+        optPtr->nbrEvaluations = 0;
+    }
+    else if(optPtr->methode == TABLE_BICUBIQUE) //interpolation, aucune itration dans le domaine de la table
+    {
+        f = interpolerTable(optPtr->tablePtr, rey, rugRel);
+        optPtr->nbrEvaluations = 0;
+        if(f == IMPOSSIBLE)
+            f = calculNewton(rey, rugRel, &optPtr->nbrEvaluations, optPtr->graine, &optPtr->critere);
+    }
+    else if(optPtr->methode == CHEBYSHEV) //polynmes, aucune itration dans le domaine du substitut
+    {
+        f = evaluerSubstitut(optPtr->substitutPtr, rey, rugRel);
+        optPtr->nbrEvaluations = 0;
+        if(f == IMPOSSIBLE)
+            f = calculNewton(rey, rugRel, &optPtr->nbrEvaluations, optPtr->graine, &optPtr->critere);
+    }
+    else //corrlation explicite, aucune itration
+    {
+        f = calculExplicite(optPtr->methode, rey, rugRel);
+        optPtr->nbrEvaluations = 0;
+    }
+    if(memo && f > 0)
+        insererMemo(optPtr->memoPtr, rey, rugRel, f, &optPtr->critere);
+    return(f);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculFrictionLot
+Paramtres :
+    rey - tableau des nombres de Reynolds
+    rugRel - tableau des rugosits relatives eps/d
+    f - tableau o crire les facteurs de friction (IMPOSSIBLE en cas d'chec)
+    statut - tableau o crire le statut de chaque lment (STATUT_OK, STATUT_SANS_RACINE,
+             STATUT_ENTREE_INVALIDE ou STATUT_NON_CONVERGE)
+    n - nombre d'lments des tableaux
+    optPtr - pointeur rfrant  la structure OPTIONS (mthode de rsolution)
+Valeur de retour :  nbrOk - nombre d'lments dont le facteur de friction a t calcul
+
+Description : Calcul par lot, indpendant de la structure DONNEES et sans affichage,
+pour rsoudre l'quation Colebrook sur des tableaux contigus d'entres. Les lments
+sont indpendants : aucune continuation n'est faite d'un lment au suivant. Avec la
+mthode de Newton, les blocs complets de LARGEUR_VECT lments passent par le noyau
+vectoriel et seuls les lments qu'il rejette sont recalculs par calculFriction().
+Avec la mmosation, le noyau vectoriel est vit comme dans resoudreIntervalle() :
+chaque lment passe par calculFriction(), qui consulte et complte la table.
+Le nombre total d'valuations de Colebrook est laiss dans optPtr->nbrEvaluations.
+Chaque fil d'excution doit utiliser sa propre structure OPTIONS.
+------------------------------------------------------------------------*/
+long calculFrictionLot(const double rey[], const double rugRel[], double f[], int statut[], long n, OPTIONS *optPtr)
+{
+    long ix;
+    long finBloc = 0; //indice qui suit le dernier lment calcul par le noyau vectoriel
+    long nbrOk = 0; //nombre d'lments calculs
+    long totalEval = 0; //nombre total d'valuations de Colebrook
+
+    optPtr->graine = 0;
+    for(ix = 0; ix < n; ix = ix + 1)
+    {
+        if(optPtr->methode == NEWTON && optPtr->noyauNewton != NULL && optPtr->memoisation == FAUX
+           && ix == finBloc && ix + LARGEUR_VECT <= n)
+        {
+            totalEval = totalEval + optPtr->noyauNewton(&rey[ix], &rugRel[ix], &f[ix], 0, &optPtr->critere);
+            finBloc = ix + LARGEUR_VECT;
+        }
+
+        if(!(rey[ix] >= VALEUR_MIN_REY) || !(rugRel[ix] >= 0)) //aussi vrai si l'entre n'est pas un nombre
+        {
+            f[ix] = IMPOSSIBLE;
+            statut[ix] = STATUT_ENTREE_INVALIDE;
+        }
+        else
+        {
+            if(ix >= finBloc || f[ix] == IMPOSSIBLE) //lment non calcul ou rejet par le noyau vectoriel
+            {
+                f[ix] = calculFriction(rey[ix], rugRel[ix], optPtr);
+                totalEval = totalEval + optPtr->nbrEvaluations;
+            }
+
+            if(f[ix] == NON_CONVERGE)
+            {
+                f[ix] = IMPOSSIBLE;
+                statut[ix] = STATUT_NON_CONVERGE;
+            }
+            else if(f[ix] == IMPOSSIBLE)
+                statut[ix] = STATUT_SANS_RACINE;
+            else
+            {
+                statut[ix] = STATUT_OK;
+                nbrOk = nbrOk + 1;
+            }
+        }
+    }
+    optPtr->nbrEvaluations = totalEval;
+    return(nbrOk);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : initCritere
+Paramtres :
+    critPtr - pointeur rfrant  la structure CRITERE
+Valeur de retour :  void
+
+Description : Affecte le critre d'arrt par dfaut des mthodes itratives.
+------------------------------------------------------------------------*/
+void initCritere(CRITERE *critPtr)
+{
+    critPtr->tolAbs = TOLERANCE_ABS;
+    critPtr->tolRel = TOLERANCE_REL;
+    critPtr->iterMax = ITER_MAX;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixCritere
+Paramtres :
+    critPtr - pointeur rfrant  la structure CRITERE
+Valeur de retour :  void
+
+Description : Demande  l'utilisateur les tolrances absolue et relative sur f et le
+nombre maximal d'itrations par point. Au moins une tolrance doit tre positive.
+------------------------------------------------------------------------*/
+void choixCritere(CRITERE *critPtr)
+{
+    do
+    {
+        critPtr->tolAbs = invitation("la tol\202rance absolue sur f");
+        critPtr->tolRel = invitation("la tol\202rance relative sur f");
+    }
+    while(critPtr->tolAbs == 0 && critPtr->tolRel == 0);
+
+    do
+        critPtr->iterMax = (int)invitation("le nombre maximal d'it\202rations par point");
+    while(critPtr->iterMax < 1);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : allouerResultats
+Paramtres :
+    resPtr - pointeur rfrant  la structure RESULTATS
+    nbrPoints - nombre de points du balayage
+    optPtr - pointeur rfrant  la structure OPTIONS (suivi, sensibilits, nombre de Reynolds variable)
+Valeur de retour :  VRAI si les tableaux sont allous, FAUX si la mmoire manque
+
+Description : Alloue (ou redimensionne) les tableaux de rsultats supplmentaires
+demands par les options. Les tableaux non demands sont laisss tels quels.
+------------------------------------------------------------------------*/
+int allouerResultats(RESULTATS *resPtr, int nbrPoints, OPTIONS *optPtr)
+{
+    int *evaltbl; //nouveau tableau d'entiers
+    double **tblPtr[6]; //tableaux de double  allouer
+    double *nouveau; //nouveau tableau de double
+    int nbrTbl = 0; //nombre de tableaux de double  allouer
+    int ok = VRAI; //drapeau : toute la mmoire est alloue
+    int ix;
+
+    if(optPtr->suivi == VRAI)
+    {
+        evaltbl = reallouerTableau(resPtr->evaltbl, nbrPoints, sizeof(int));
+        if(evaltbl != NULL)
+            resPtr->evaltbl = evaltbl;
+        else
+            ok = FAUX;
+        tblPtr[nbrTbl] = &resPtr->residutbl;
+        nbrTbl = nbrTbl + 1;
+    }
+    if(optPtr->sensibilites == VRAI)
+    {
+        tblPtr[nbrTbl] = &resPtr->dfdDtbl;
+        tblPtr[nbrTbl+1] = &resPtr->dfdReytbl;
+        tblPtr[nbrTbl+2] = &resPtr->dfdEpstbl;
+        nbrTbl = nbrTbl + 3;
+    }
+    if(optPtr->reyVariable == VRAI)
+    {
+        tblPtr[nbrTbl] = &resPtr->reytbl;
+        tblPtr[nbrTbl+1] = &resPtr->vittbl;
+        nbrTbl = nbrTbl + 2;
+    }
+
+    for(ix = 0; ix < nbrTbl; ix = ix + 1)
+    {
+        nouveau = reallouerTableau(*tblPtr[ix], nbrPoints, sizeof(double));
+        if(nouveau != NULL)
+            *tblPtr[ix] = nouveau;
+        else
+            ok = FAUX;
+    }
+
+    if(ok == FAUX)
+        printf("\n - ERREUR! M\202moire insuffisante pour les r\202sultats suppl\202mentaires de %d diam\212tres.\n", nbrPoints);
+    return(ok);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : libererResultats
+Paramtres :
+    resPtr - pointeur rfrant  la structure RESULTATS
+Valeur de retour :  void
+
+Description : Libre les tableaux de rsultats supplmentaires.
+------------------------------------------------------------------------*/
+void libererResultats(RESULTATS *resPtr)
+{
+    free(resPtr->evaltbl);
+    free(resPtr->residutbl);
+    free(resPtr->dfdDtbl);
+    free(resPtr->dfdReytbl);
+    free(resPtr->dfdEpstbl);
+    free(resPtr->reytbl);
+    free(resPtr->vittbl);
+    resPtr->evaltbl = NULL;
+    resPtr->residutbl = NULL;
+    resPtr->dfdDtbl = NULL;
+    resPtr->dfdReytbl = NULL;
+    resPtr->dfdEpstbl = NULL;
+    resPtr->reytbl = NULL;
+    resPtr->vittbl = NULL;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheSuivi
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    resPtr - pointeur rfrant  la structure RESULTATS
+Valeur de retour :  void
+
+Description : Rsume le suivi par point : nombre moyen et maximal d'valuations de
+Colebrook, et rsidu final maximal, avec les diamtres o les maximums sont atteints.
+------------------------------------------------------------------------*/
+void afficheSuivi(DONNEES *dPtr, RESULTATS *resPtr)
+{
+    int ix;
+    long somme = 0; //somme des valuations
+    int iEvalMax = 0, iResiduMax = 0; //indices des maximums
+
+    for(ix = 0; ix < dPtr->nbrPoints; ix = ix + 1)
+    {
+        somme = somme + resPtr->evaltbl[ix];
+        if(resPtr->evaltbl[ix] > resPtr->evaltbl[iEvalMax])
+            iEvalMax = ix;
+        if(resPtr->residutbl[ix] > resPtr->residutbl[iResiduMax])
+            iResiduMax = ix;
+    }
+
+    printf("\nSuivi : %.2f \202valuations par point en moyenne, au plus %d (diam\212tre %g m).",
+           (double)somme/dPtr->nbrPoints, resPtr->evaltbl[iEvalMax], dPtr->dtbl[iEvalMax]);
+    printf("\nR\202sidu final maximal de Colebrook : %.3e (diam\212tre %g m).", resPtr->residutbl[iResiduMax], dPtr->dtbl[iResiduMax]);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : afficheSensibilites
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    resPtr - pointeur rfrant  la structure RESULTATS
+Valeur de retour :  void
+
+Description : Affiche les sensibilits du facteur de friction aux diamtres minimal et
+maximal du balayage.
+------------------------------------------------------------------------*/
+void afficheSensibilites(DONNEES *dPtr, RESULTATS *resPtr)
+{
+    int dernier = dPtr->nbrPoints - 1; //indice du diamtre maximal
+
+    printf("\nSensibilit\202s :        df/dd (1/m)    df/drey        df/deps (1/m)");
+    printf("\n  d = %-10g %14.6e %14.6e %14.6e", dPtr->dtbl[0], resPtr->dfdDtbl[0], resPtr->dfdReytbl[0], resPtr->dfdEpstbl[0]);
+    printf("\n  d = %-10g %14.6e %14.6e %14.6e", dPtr->dtbl[dernier], resPtr->dfdDtbl[dernier], resPtr->dfdReytbl[dernier], resPtr->dfdEpstbl[dernier]);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculBissection
+Paramtres :
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+    nbrEvalPtr - pointeur o crire le nombre d'valuations de calculColebrook()
+    graine - estimation de la racine (solution d'un point voisin), ou 0 si aucune
+    critPtr - pointeur rfrant au critre d'arrt
+Valeur de retour :  temp - valeur de la racine trouve, IMPOSSIBLE ou NON_CONVERGE
+
+Description : Cette fonction utilise la mthode de bissection et la fonction calculColebrook()
+afin de trouver la valeur du facteur de friction. Les valeurs de
+Colebrook aux bornes sont conserves d'une itration  l'autre, de sorte que chaque
+itration n'value Colebrook qu'une seule fois, au milieu. Avec une graine, la
+bissection commence dans l'intervalle troit graine*(1 +/- ECART_GRAINE) et ne reprend
+l'intervalle complet que si la racine n'y est pas. La bissection s'arrte lorsque la
+largeur de l'intervalle en f respecte le critre d'arrt, ce qui borne directement
+l'erreur sur f, et retourne NON_CONVERGE si critPtr->iterMax itrations ne suffisent pas.
+------------------------------------------------------------------------*/
+double calculBissection(double rey, double rugRel, long *nbrEvalPtr, double graine, const CRITERE *critPtr)
+{
+    double haut, bas, temp;
+    double gHaut, gBas, gTemp; //valeurs de Colebrook  haut, bas et temp
+    int iter = 0; //nombre d'itrations
+
+    *nbrEvalPtr = 0;
+    if(graine > 0) //continuation : intervalle troit autour de la graine
+    {
+        haut = graine*(1 + ECART_GRAINE);
+        bas = graine*(1 - ECART_GRAINE);
+        gHaut = calculColebrook(haut, rey, rugRel);
+        gBas = calculColebrook(bas, rey, rugRel);
+        *nbrEvalPtr = 2;
+    }
+
+    if(graine <= 0 || gHaut*gBas >= 0) //aucune graine, ou la racine n'est pas prs de la graine
+    {
+        haut = HAUT; //borne suprieure
+        bas = PRESQUE_0; //borne infrieure
+        gHaut = calculColebrook(haut, rey, rugRel);
+        gBas = calculColebrook(bas, rey, rugRel);
+        *nbrEvalPtr = *nbrEvalPtr + 2;
+    }
+    temp = (haut+bas)/2; //borne du milieu
+
+    if(gHaut*gBas < 0) //si racine existe
+    {
+        gTemp = calculColebrook(temp, rey, rugRel);
+        *nbrEvalPtr = *nbrEvalPtr + 1;
+
+        //tant et autant que l'intervalle est plus large que la tolrance sur f
+        //si le facteur de friction  temp = 0, c'est la racine
+        while(haut - bas > critPtr->tolAbs + critPtr->tolRel*temp && gTemp != 0 && iter < critPtr->iterMax)
+        {
+            if(gHaut*gTemp < 0) //si racine est dans demi suprieure
+            {
+                bas = temp;
+                gBas = gTemp;
+            }
+            else if(gBas*gTemp < 0) //si racine est dans demi infrieur
+            {
+                haut = temp;
+                gHaut = gTemp;
+            }
+
+            temp = (haut+bas)/2; //affecte la nouvelle valeur du mileu
+            gTemp = calculColebrook(temp, rey, rugRel);
+            *nbrEvalPtr = *nbrEvalPtr + 1;
+            iter = iter + 1;
+        }
+        if(haut - bas > critPtr->tolAbs + critPtr->tolRel*temp && gTemp != 0) //budget puis
+            temp = NON_CONVERGE;
+    }
+    else //si il n'a pas de racine
+        temp = IMPOSSIBLE;// valeur de -1
+
+    return(temp);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculNewton
+Paramtres :
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+    nbrEvalPtr - pointeur o crire le nombre d'valuations de calculColebrookX()
+    graine - estimation de la racine (solution d'un point voisin), ou 0 si aucune
+    critPtr - pointeur rfrant au critre d'arrt
+Valeur de retour :  f - valeur de la racine trouve, IMPOSSIBLE ou NON_CONVERGE
+
+Description : Cette fonction utilise la mthode de Newton-Raphson sur la variable
+x = 1/sqrt(f), pour laquelle l'quation Colebrook est lisse et croissante. L'existence
+de la racine est vrifie sur le mme intervalle que la bissection (PRESQUE_0  HAUT).
+L'estimation initiale est une itration de point fixe de Colebrook. Un pas de Newton qui
+sort de l'intervalle connu est remplac par un pas de bissection, ce qui garantit la
+convergence. Comme f = 1/x^2, une erreur dx sur x donne une erreur 2*f*dx/x sur f :
+le critre d'arrt sur f devient |dx| <= x*(tolAbs*x^2 + tolRel)/2. Converge normalement
+en 3  5 itrations; retourne NON_CONVERGE si le critre n'est pas atteint aprs
+critPtr->iterMax itrations au total, graine comprise.
+Avec une graine, la mthode fait d'abord au plus ITER_GRAINE pas de Newton  partir
+de la graine, sans vrification pralable de l'intervalle. Si ces pas ne convergent pas
+vers une racine de l'intervalle, la mthode reprend au complet sans la graine.
+------------------------------------------------------------------------*/
+double calculNewton(double rey, double rugRel, long *nbrEvalPtr, double graine, const CRITERE *critPtr)
+{
+    double xBas, xHaut; //intervalle qui contient la racine en x
+    double x, xNouv; //estimation courante et suivante
+    double g, gPrime; //valeur de Colebrook et sa drive
+    int iter = 0; //nombre d'itrations
+    int converge = FAUX; //drapeau de convergence
+
+    xBas = 1/sqrt(HAUT); //f = HAUT correspond au plus petit x
+    xHaut = 1/sqrt(PRESQUE_0); //f = PRESQUE_0 correspond au plus grand x
+
+    *nbrEvalPtr = 0;
+    if(graine > 0) //continuation : Newton  partir de la graine
+    {
+        x = 1/sqrt(graine);
+        while(converge == FAUX && iter < ITER_GRAINE && iter < critPtr->iterMax)
+        {
+            g = calculColebrookX(x, rey, rugRel, &gPrime);
+            *nbrEvalPtr = *nbrEvalPtr + 1;
+            xNouv = x - g/gPrime; //pas de Newton
+
+            if(fabs(xNouv - x) <= 0.5*xNouv*(critPtr->tolAbs*xNouv*xNouv + critPtr->tolRel))
+                converge = VRAI;
+
+            x = xNouv;
+            iter = iter + 1;
+        }
+        if(converge == VRAI && x > xBas && x < xHaut)
+            return(1/(x*x));
+
+        //la graine a chou, reprend avec l'intervalle complet (les itrations comptent dans le budget)
+        converge = FAUX;
+    }
+
+    *nbrEvalPtr = *nbrEvalPtr + 2;
+    if(calculColebrookX(xBas, rey, rugRel, &gPrime)*calculColebrookX(xHaut, rey, rugRel, &gPrime) >= 0) //si racine n'existe pas
+        return(IMPOSSIBLE);
+
+    //estimation initiale : une itration de point fixe  partir de f = 1/64
+    x = -2.0*log10(rugRel/3.7 + 2.51*8.0/rey);
+    if(x <= xBas || x >= xHaut)
+        x = (xBas + xHaut)/2;
+
+    while(converge == FAUX && iter < critPtr->iterMax)
+    {
+        g = calculColebrookX(x, rey, rugRel, &gPrime);
+        *nbrEvalPtr = *nbrEvalPtr + 1;
+
+        //la fonction est croissante : resserre l'intervalle selon le signe
+        if(g < 0)
+            xBas = x;
+        else
+            xHaut = x;
+
+        xNouv = x - g/gPrime; //pas de Newton
+        if(xNouv < xBas || xNouv > xHaut) //pas hors de l'intervalle, utilise la bissection
+            xNouv = (xBas + xHaut)/2;
+
+        if(fabs(xNouv - x) <= 0.5*xNouv*(critPtr->tolAbs*xNouv*xNouv + critPtr->tolRel))
+            converge = VRAI;
+
+        x = xNouv;
+        iter = iter + 1;
+    }
+    if(converge == FAUX)
+        return(NON_CONVERGE);
+    return(1/(x*x));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : corpsNewtonBloc
+Paramtres :
+    rey - tableau de LARGEUR_VECT nombres de Reynolds
+    rugRel - tableau de LARGEUR_VECT rugosits relatives eps/d
+    ftbl - tableau o crire les LARGEUR_VECT facteurs de friction
+    graine - estimation commune  toutes les voies (solution d'un point voisin), ou 0
+    critPtr - pointeur rfrant au critre d'arrt (voir calculNewton())
+Valeur de retour :  nbrEval - nombre d'valuations de Colebrook (toutes les voies comptes)
+
+Description : Version vectorielle de calculNewton() qui rsout l'quation Colebrook
+pour LARGEUR_VECT points  la fois. Chaque voie du vecteur fait la mme itration de
+Newton en x = 1/sqrt(f) (qui n'a besoin d'aucune racine carre) avec un logarithme
+vectoriel, log10Vect(). Une voie qui a converg est fige par un masque, et la boucle
+s'arrte lorsque toutes les voies ont converg. Une voie qui n'a pas converg, qui sort
+de l'intervalle PRESQUE_0  HAUT ou dont le logarithme n'est pas dfini reoit IMPOSSIBLE :
+l'appelant doit alors la recalculer avec calculFriction().
+Le corps est toujours insr dans la fonction appelante, de sorte que chaque version
+de calculNewtonBloc() (voir plus bas) est compile avec son propre jeu d'instructions.
+------------------------------------------------------------------------*/
+static inline int corpsNewtonBloc(const double rey[], const double rugRel[], double ftbl[], double graine, const CRITERE *critPtr)
+{
+    VECT_DOUBLE a, b; //eps/(3.7*d) et 2.51/rey pour chaque voie
+    VECT_DOUBLE x, dx; //estimation de 1/sqrt(f) et pas de Newton
+    VECT_DOUBLE seuil; //plus grand pas accept pour la convergence
+    VECT_DOUBLE terme, logTerme, g, gPrime; //argument du logarithme, son logarithme, Colebrook et sa drive
+    VECT_ENTIER actif; //masque des voies qui n'ont pas converg (-1 si actif, 0 sinon)
+    VECT_ENTIER echec; //masque des voies dont le logarithme n'est pas dfini
+    int ix;
+    int iter = 0; //nombre d'itrations
+    int nbrActifs = LARGEUR_VECT; //nombre de voies actives
+
+    for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+    {
+        a[ix] = rugRel[ix]/3.7;
+        b[ix] = 2.51/rey[ix];
+    }
+
+    //estimation initiale : la graine (continuation) ou une itration de point fixe  partir de f = 1/64
+    terme = a + b*8.0;
+    echec = terme <= 0;
+    if(graine > 0)
+    {
+        for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+            x[ix] = 1/sqrt(graine);
+    }
+    else
+    {
+        log10Vect(&terme, &logTerme);
+        x = -2.0*logTerme;
+    }
+    actif = echec == 0;
+
+    while(nbrActifs > 0 && iter < critPtr->iterMax)
+    {
+        terme = a + b*x;
+        echec = echec | (terme <= 0);
+        log10Vect(&terme, &logTerme);
+        g = x + 2.0*logTerme;
+        gPrime = 1 + 2.0*b/(LN10*terme);
+        dx = g/gPrime;
+
+        //seules les voies actives avancent
+        x = x - (VECT_DOUBLE)((VECT_ENTIER)dx & actif);
+        seuil = 0.5*x*(critPtr->tolAbs*x*x + critPtr->tolRel);
+        actif = actif & ((dx > seuil) | (dx < -seuil)) & (echec == 0);
+
+        nbrActifs = 0;
+        for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+            if(actif[ix])
+                nbrActifs = nbrActifs + 1;
+        iter = iter + 1;
+    }
+
+    for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+    {
+        if(actif[ix] || echec[ix] || !(x[ix] > 1/sqrt(HAUT) && x[ix] < 1/sqrt(PRESQUE_0)))
+            ftbl[ix] = IMPOSSIBLE;
+        else
+            ftbl[ix] = 1/(x[ix]*x[ix]);
+    }
+    return(iter*LARGEUR_VECT);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculNewtonBlocFloat
+Paramtres :
+    rey - tableau de LARGEUR_VECT_FLOAT nombres de Reynolds
+    rugRel - tableau de LARGEUR_VECT_FLOAT rugosits relatives eps/d
+    ftbl - tableau o crire les LARGEUR_VECT_FLOAT facteurs de friction
+    raffiner - VRAI pour faire un pas de Newton en double aprs le calcul en float
+Valeur de retour :  nbrEval - nombre d'valuations de Colebrook (toutes les voies comptes)
+
+Description : Version en simple prcision du noyau vectoriel de Newton. Un vecteur de
+float contient deux fois plus de voies qu'un vecteur de double de mme taille : les
+LARGEUR_VECT_FLOAT points sont rsolus par ITER_FLOAT pas de Newton, sans test,  partir
+d'une itration de point fixe, comme DEFINIR_COLEBROOK_FIXE. L'erreur relative sur f est alors
+d'environ 1E-6. Si raffiner est VRAI, chaque moiti du bloc fait ensuite un seul pas de
+Newton en double prcision, ce qui suffit, grce  la convergence quadratique, pour
+retrouver presque la prcision de double. Une voie dont le logarithme n'est pas dfini
+ou dont le rsultat sort de l'intervalle PRESQUE_0  HAUT reoit IMPOSSIBLE : l'appelant
+doit alors la recalculer avec calculFriction(). Le nombre de pas tant fixe, ce noyau
+ignore le critre d'arrt de l'utilisateur.
+------------------------------------------------------------------------*/
+int calculNewtonBlocFloat(const double rey[], const double rugRel[], double ftbl[], int raffiner)
+{
+    VECT_FLOAT a, b; //eps/(3.7*d) et 2.51/rey en float
+    VECT_FLOAT x, terme, lnTerme; //estimation de 1/sqrt(f), argument du logarithme et son logarithme
+    VECT_ENTIER_FLOAT echec; //masque des voies dont le logarithme n'est pas dfini
+    VECT_DOUBLE ad, bd, xd, termeD, logTerme; //pas de raffinement en double
+    VECT_ENTIER echecD; //masque des voies du raffinement dont le logarithme n'est pas dfini
+    int ix, jx;
+    int iter;
+
+    for(ix = 0; ix < LARGEUR_VECT_FLOAT; ix = ix + 1)
+    {
+        a[ix] = (float)(rugRel[ix]/3.7);
+        b[ix] = (float)(2.51/rey[ix]);
+    }
+
+    terme = a + b*8.0f;
+    echec = terme <= 0;
+    lnVectFloat(&terme, &lnTerme);
+    x = -(float)DEUX_SUR_LN10*lnTerme;
+    for(iter = 0; iter < ITER_FLOAT; iter = iter + 1)
+    {
+        terme = a + b*x;
+        echec = echec | (terme <= 0);
+        lnVectFloat(&terme, &lnTerme);
+        x = x - (x + (float)DEUX_SUR_LN10*lnTerme)/(1.0f + (float)DEUX_SUR_LN10*b/terme);
+    }
+
+    for(jx = 0; jx < LARGEUR_VECT_FLOAT; jx = jx + LARGEUR_VECT) //une moiti du bloc  la fois en double
+    {
+        for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+        {
+            xd[ix] = x[jx+ix];
+            echecD[ix] = echec[jx+ix];
+        }
+        if(raffiner)
+        {
+            for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+            {
+                ad[ix] = rugRel[jx+ix]/3.7;
+                bd[ix] = 2.51/rey[jx+ix];
+            }
+            termeD = ad + bd*xd;
+            echecD = echecD | (termeD <= 0);
+            log10Vect(&termeD, &logTerme);
+            xd = xd - (xd + 2.0*logTerme)/(1 + 2.0*bd/(LN10*termeD));
+        }
+        for(ix = 0; ix < LARGEUR_VECT; ix = ix + 1)
+        {
+            if(echecD[ix] || !(xd[ix] > 1/sqrt(HAUT) && xd[ix] < 1/sqrt(PRESQUE_0)))
+                ftbl[jx+ix] = IMPOSSIBLE;
+            else
+                ftbl[jx+ix] = 1/(xd[ix]*xd[ix]);
+        }
+    }
+    return(LARGEUR_VECT_FLOAT*(ITER_FLOAT + (raffiner ? 1 : 0)));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : lnVectFloat
+Paramtres :
+    vPtr - pointeur rfrant au vecteur de valeurs positives
+    lnPtr - pointeur o crire le vecteur des logarithmes naturels
+Valeur de retour :  void
+
+Description : Logarithme naturel vectoriel en simple prcision, calcul comme
+log10Vect(), mais avec la srie de 2*atanh(t) tronque aprs le terme en t^9, ce qui
+suffit pour la prcision de float.
+------------------------------------------------------------------------*/
+static inline void lnVectFloat(VECT_FLOAT *vPtr, VECT_FLOAT *lnPtr)
+{
+    VECT_ENTIER_FLOAT bits, exposant, grand;
+    VECT_FLOAT m, t, t2, serie;
+
+    bits = (VECT_ENTIER_FLOAT)*vPtr;
+    exposant = ((bits >> 23) & 0xff) - 127;
+    m = (VECT_FLOAT)((bits & 0x007fffff) | 0x3f800000); //mantisse entre 1 et 2
+
+    grand = m > (float)RACINE_2; //divise la mantisse par 2 si elle dpasse sqrt(2)
+    m = (VECT_FLOAT)(((VECT_ENTIER_FLOAT)(m*0.5f) & grand) | ((VECT_ENTIER_FLOAT)m & ~grand));
+    exposant = exposant - grand;
+
+    t = (m - 1)/(m + 1);
+    t2 = t*t;
+    serie = t2*(1.0f/9) + 1.0f/7;
+    serie = serie*t2 + 1.0f/5;
+    serie = serie*t2 + 1.0f/3;
+    serie = serie*t2 + 1.0f;
+
+    *lnPtr = __builtin_convertvector(exposant, VECT_FLOAT)*(float)LN2 + 2.0f*t*serie;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : nomPrecision
+Paramtres :
+    precision - prcision du noyau de Newton
+Valeur de retour :  nom - chane de caractres qui dcrit la prcision
+
+Description : Retourne le nom de la prcision, pour l'affichage.
+------------------------------------------------------------------------*/
+char *nomPrecision(int precision)
+{
+    char *nom;
+
+    switch(precision)
+    {
+        case PRECISION_SIMPLE:      nom = "simple pr\202cision"; break;
+        case PRECISION_RAFFINEE:    nom = "simple pr\202cision raffin\202e en double"; break;
+        default:                    nom = "double pr\202cision"; break;
+    }
+    return(nom);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : precisionNewton
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  prcision rellement utilise par la mthode de Newton
+
+Description : Le noyau en simple prcision n'est utilis que si aucune option n'impose le
+calcul scalaire : noyau scalaire choisi (noyauNewton  NULL), suivi de chaque point ou
+mmosation. Sinon, Newton calcule en double prcision avec calculNewton(), quelle que
+soit la prcision choisie.
+------------------------------------------------------------------------*/
+int precisionNewton(OPTIONS *optPtr)
+{
+    if(optPtr->noyauNewton == NULL || optPtr->suivi == VRAI || optPtr->memoisation == VRAI)
+        return(PRECISION_DOUBLE);
+    return(optPtr->precision);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculNewtonBloc, calculNewtonBlocSSE42, calculNewtonBlocAVX2, calculNewtonBlocAVX512
+Paramtres :
+    voir corpsNewtonBloc()
+Valeur de retour :  nbrEval - nombre d'valuations de Colebrook (toutes les voies comptes)
+
+Description : Versions du noyau vectoriel de Newton. calculNewtonBloc() utilise le jeu
+d'instructions de base de la compilation (SSE2 en x86-64). Les autres versions sont
+compiles pour un jeu d'instructions plus rcent avec l'attribut target de gcc : elles
+ne doivent tre appeles que si le processeur le supporte (voir choisirNoyau()).
+------------------------------------------------------------------------*/
+int calculNewtonBloc(const double rey[], const double rugRel[], double ftbl[], double graine, const CRITERE *critPtr)
+{
+    return(corpsNewtonBloc(rey, rugRel, ftbl, graine, critPtr));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse4.2")))
+int calculNewtonBlocSSE42(const double rey[], const double rugRel[], double ftbl[], double graine, const CRITERE *critPtr)
+{
+    return(corpsNewtonBloc(rey, rugRel, ftbl, graine, critPtr));
+}
+
+__attribute__((target("avx2,fma")))
+int calculNewtonBlocAVX2(const double rey[], const double rugRel[], double ftbl[], double graine, const CRITERE *critPtr)
+{
+    return(corpsNewtonBloc(rey, rugRel, ftbl, graine, critPtr));
+}
+
+__attribute__((target("avx512f")))
+int calculNewtonBlocAVX512(const double rey[], const double rugRel[], double ftbl[], double graine, const CRITERE *critPtr)
+{
+    return(corpsNewtonBloc(rey, rugRel, ftbl, graine, critPtr));
+}
+#endif
+
+/*-----------------------------------------------------------------------
+Fonction : noyauSupporte
+Paramtres :
+    noyau - noyau de Newton (NOYAU_SCALAIRE  NOYAU_AVX512)
+Valeur de retour :  VRAI si le processeur peut excuter ce noyau, FAUX sinon
+
+Description : Interroge le processeur avec __builtin_cpu_supports(). Hors x86, seuls
+les noyaux scalaire et gnrique sont disponibles.
+------------------------------------------------------------------------*/
+int noyauSupporte(int noyau)
+{
+    int supporte; //drapeau
+
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    switch(noyau)
+    {
+        case NOYAU_SSE42:   supporte = __builtin_cpu_supports("sse4.2"); break;
+        case NOYAU_AVX2:    supporte = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"); break;
+        case NOYAU_AVX512:  supporte = __builtin_cpu_supports("avx512f"); break;
+        default:            supporte = noyau == NOYAU_SCALAIRE || noyau == NOYAU_GENERIQUE; break;
+    }
+#else
+    supporte = noyau == NOYAU_SCALAIRE || noyau == NOYAU_GENERIQUE;
+#endif
+    return(supporte ? VRAI : FAUX);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choisirNoyau
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  void
+
+Description : Choisit le noyau de Newton selon optPtr->noyau. Avec NOYAU_AUTO, ou si
+le noyau demand n'est pas support par le processeur, le meilleur noyau support est
+choisi. Le choix est fait une seule fois : la boucle de calcul n'appelle ensuite que
+optPtr->noyauNewton.
+------------------------------------------------------------------------*/
+void choisirNoyau(OPTIONS *optPtr)
+{
+    int noyau; //noyau choisi
+
+    if(optPtr->noyau != NOYAU_AUTO && noyauSupporte(optPtr->noyau) == VRAI)
+        noyau = optPtr->noyau;
+    else
+    {
+        noyau = NOYAU_AVX512;
+        while(noyauSupporte(noyau) == FAUX)
+            noyau = noyau - 1;
+    }
+
+    optPtr->noyauChoisi = noyau;
+    switch(noyau)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        case NOYAU_SSE42:   optPtr->noyauNewton = calculNewtonBlocSSE42; break;
+        case NOYAU_AVX2:    optPtr->noyauNewton = calculNewtonBlocAVX2; break;
+        case NOYAU_AVX512:  optPtr->noyauNewton = calculNewtonBlocAVX512; break;
+#endif
+        case NOYAU_GENERIQUE:   optPtr->noyauNewton = calculNewtonBloc; break;
+        default:                optPtr->noyauNewton = NULL; break;
+    }
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixNoyau
+Paramtres :
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  void
+
+Description : Demande  l'utilisateur le noyau de Newton  utiliser. Les noyaux que
+le processeur ne supporte pas sont indiqus et refuss.
+------------------------------------------------------------------------*/
+void choixNoyau(OPTIONS *optPtr)
+{
+    int choix; //choix de l'utilisateur
+    int ix;
+
+    printf("\nNoyau de Newton : \n");
+    for(ix = NOYAU_AUTO; ix <= NOYAU_AVX512; ix = ix + 1)
+        printf("%d) %s%s\n", ix, ix == NOYAU_AUTO ? "automatique" : nomNoyau(ix),
+               noyauSupporte(ix) == VRAI || ix == NOYAU_AUTO ? "" : " (non support\202 par ce processeur)");
+
+    do
+    {
+        printf("Entrez un chiffre de %d \205 %d : ", NOYAU_AUTO, NOYAU_AVX512);
+        fflush(stdin);
+        scanf("%d", &choix);
+    }
+    while(choix < NOYAU_AUTO || choix > NOYAU_AVX512 || (choix != NOYAU_AUTO && noyauSupporte(choix) == FAUX));
+
+    optPtr->noyau = choix;
+    choisirNoyau(optPtr);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : nomNoyau
+Paramtres :
+    noyau - noyau de Newton
+Valeur de retour :  nom - chane de caractres qui dcrit le noyau
+
+Description : Retourne le nom du noyau de Newton, pour l'affichage.
+------------------------------------------------------------------------*/
+char *nomNoyau(int noyau)
+{
+    char *nom;
+
+    switch(noyau)
+    {
+        case NOYAU_SCALAIRE:    nom = "scalaire"; break;
+        case NOYAU_GENERIQUE:   nom = "vectoriel g\202n\202rique"; break;
+        case NOYAU_SSE42:       nom = "vectoriel SSE4.2"; break;
+        case NOYAU_AVX2:        nom = "vectoriel AVX2+FMA"; break;
+        default:                nom = "vectoriel AVX-512"; break;
+    }
+    return(nom);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : log10Vect
+Paramtres :
+    vPtr - pointeur rfrant au vecteur de valeurs positives
+    logPtr - pointeur o crire le vecteur des logarithmes en base 10
+Valeur de retour :  void
+
+Description : Logarithme vectoriel. L'exposant binaire de chaque voie est extrait
+directement des bits du nombre et la mantisse est ramene entre sqrt(1/2) et sqrt(2).
+Le logarithme de la mantisse m est calcul par la srie de 2*atanh(t), t = (m-1)/(m+1),
+tronque aprs le terme en t^23 (|t| < 0.172), ce qui donne la prcision machine pour
+toutes les valeurs normales positives.
+------------------------------------------------------------------------*/
+static inline void log10Vect(VECT_DOUBLE *vPtr, VECT_DOUBLE *logPtr)
+{
+    VECT_ENTIER bits, exposant, grand;
+    VECT_DOUBLE m, t, t2, serie;
+
+    bits = (VECT_ENTIER)*vPtr;
+    exposant = ((bits >> 52) & 0x7ff) - 1023;
+    m = (VECT_DOUBLE)((bits & 0x000fffffffffffffLL) | 0x3ff0000000000000LL); //mantisse entre 1 et 2
+
+    grand = m > RACINE_2; //divise la mantisse par 2 si elle dpasse sqrt(2)
+    m = (VECT_DOUBLE)(((VECT_ENTIER)(m*0.5) & grand) | ((VECT_ENTIER)m & ~grand));
+    exposant = exposant - grand;
+
+    t = (m - 1)/(m + 1);
+    t2 = t*t;
+    serie = t2*(1.0/23) + 1.0/21;
+    serie = serie*t2 + 1.0/19;
+    serie = serie*t2 + 1.0/17;
+    serie = serie*t2 + 1.0/15;
+    serie = serie*t2 + 1.0/13;
+    serie = serie*t2 + 1.0/11;
+    serie = serie*t2 + 1.0/9;
+    serie = serie*t2 + 1.0/7;
+    serie = serie*t2 + 1.0/5;
+    serie = serie*t2 + 1.0/3;
+    serie = serie*t2 + 1.0;
+
+    *logPtr = (__builtin_convertvector(exposant, VECT_DOUBLE)*LN2 + 2.0*t*serie)/LN10;
+}
+
+/*-----------------------------------------------------------------------
+Macro : DEFINIR_COLEBROOK_FIXE
+Paramtres :
+    NOM - nom de la fonction gnre
+    TYPE - type des calculs (double ou long double)
+    LOG - logarithme naturel de ce type (log, logl...)
+    NBR_ITER - nombre de pas de Newton, fix  la compilation
+    DEPART - estimation initiale : DEPART_POINT_FIXE (une itration de point fixe 
+             partir de f = 1/64)
+Valeur de retour de la fonction gnre :  f - facteur de friction
+
+Description : Gnre une fonction TYPE NOM(TYPE rey, TYPE rugRel) qui fait exactement
+NBR_ITER pas de Newton en x = 1/sqrt(f) sur l'quation Colebrook. La boucle est
+droule par le compilateur et ne contient aucun test : ni vrification de
+l'intervalle, ni test de convergence. Les constantes sont converties dans TYPE  la
+compilation. Comme g(x) est croissante et concave, la tangente reste au-dessus de la
+courbe : ds le premier pas, les itrs approchent la racine par la gauche sans la
+dpasser. L'appelant doit garantir que la racine existe (rey >= VALEUR_MIN_REY et
+rugosit relative raliste, par exemple dans le domaine de la table) et choisir la
+plus petite variante assez prcise pour son usage. Seules les variantes utilises sont
+gnres (noeuds et rfrence de la table, voir construireTable()). Pour
+4000 <= rey <= 1E8 et 0 <= eps/d <= 0.05, l'erreur relative maximale sur f, mesure
+par rapport  8 pas en long double, est de :
+    colebrookDouble3 :      7E-16, prcision de double
+    colebrookLongDouble4 :  4E-19, prcision de long double
+------------------------------------------------------------------------*/
+DEFINIR_COLEBROOK_FIXE(colebrookDouble3, double, log, 3, DEPART_POINT_FIXE)
+DEFINIR_COLEBROOK_FIXE(colebrookLongDouble4, long double, logl, 4, DEPART_POINT_FIXE)
+
+/*-----------------------------------------------------------------------
+Fonction : calculOmega
+Paramtres :
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+Valeur de retour :  f - valeur de la racine, ou IMPOSSIBLE
+
+Description : Cette fonction calcule la solution exacte de l'quation Colebrook 
+l'aide de la fonction omga de Wright, sans bissection ni itration. En posant
+a = eps/(3.7*d), b = 2.51/rey et c = 2/ln(10), l'quation x = -2*log10(a + b*x)
+devient w + ln(w) = z, avec z = a/(b*c) - ln(b*c) et a + b*x = b*c*w. On obtient
+alors x = -2*log10(b*c*w), forme qui vite la soustraction de grands nombres pour
+les conduits rugueux. Retourne IMPOSSIBLE si x est hors de l'intervalle utilis par
+les mthodes itratives.
+------------------------------------------------------------------------*/
+double calculOmega(double rey, double rugRel)
+{
+    double a, bc; //termes de Colebrook
+    double x; //solution en x = 1/sqrt(f)
+
+    a = rugRel/3.7;
+    bc = 2.51/rey*2.0/LN10;
+    x = -2.0*log10(bc*omegaWright(a/bc - log(bc)));
+
+    if(!(x > 1/sqrt(HAUT) && x < 1/sqrt(PRESQUE_0))) //aussi vrai si x n'est pas un nombre
+        return(IMPOSSIBLE);
+    return(1/(x*x));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : omegaWright
+Paramtres :
+    z - argument rel de la fonction
+Valeur de retour :  w - valeur de omga(z), la solution de w + ln(w) = z
+
+Description : Cette fonction calcule la fonction omga de Wright. L'estimation
+initiale vient d'un dveloppement asymptotique (z > 1), d'une srie autour de z = 1
+(-2 < z <= 1) ou de exp(z) (z <= -2). Elle est ensuite raffine par ITER_OMEGA pas
+de l'itration d'ordre 4 de Fritsch, Shafer et Crowley, ce qui suffit pour atteindre
+la prcision machine sur tout l'axe rel. Le nombre d'oprations est donc fixe.
+------------------------------------------------------------------------*/
+double omegaWright(double z)
+{
+    double w; //estimation de omga
+    double r, q; //rsidu et terme de correction
+    double t; //cart  z = 1
+    int ix;
+
+    if(z > 1)
+    {
+        t = log(z);
+        w = z - t + t/z;
+    }
+    else if(z > -2)
+    {
+        t = z - 1;
+        w = 1 + t/2 + t*t/16 - t*t*t/192;
+    }
+    else
+        w = exp(z);
+
+    for(ix = 0; ix < ITER_OMEGA; ix = ix + 1)
+    {
+        r = z - w - log(w);
+        q = 2*(1 + w)*(1 + w + 2*r/3);
+        w = w*(1 + r/(1 + w)*(q - r)/(q - 2*r));
+    }
+    return(w);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculExplicite
+Paramtres :
+    methode - corrlation  utiliser (HAALAND  GOUDAR_SONNAD)
+    rey - nombre de Reynolds
+    r - rugosit relative eps/d du conduit
+Valeur de retour :  f - approximation du facteur de friction, ou IMPOSSIBLE
+
+Description : Cette fonction calcule directement, sans itration, une approximation
+explicite de la solution de l'quation Colebrook. Les corrlations sont crites en
+fonction de x = 1/sqrt(f), avec r = eps/d :
+    Haaland :           x = -1.8*log10((r/3.7)^1.11 + 6.9/rey)
+    Swamee-Jain :       x = -2*log10(r/3.7 + 5.74/rey^0.9)
+    Serghides :         trois itrations de point fixe acclres par Steffensen
+    Zigrang-Sylvester : x = -2*log10(r/3.7 - 5.02/rey*log10(r/3.7 - 5.02/rey*log10(r/3.7 + 13/rey)))
+    Goudar-Sonnad :     approximation de la fonction W de Lambert par fraction continue
+Retourne IMPOSSIBLE si x est hors de l'intervalle utilis par les mthodes itratives.
+------------------------------------------------------------------------*/
+double calculExplicite(int methode, double rey, double r)
+{
+    double x; //approximation de 1/sqrt(f)
+    double a, b, c; //termes de Serghides
+    double gsA, gsB, gsD, gsS, gsQ, gsG, gsZ, gsDla, gsDcfa; //termes de Goudar-Sonnad
+
+    switch(methode)
+    {
+        case HAALAND:
+            x = -1.8*log10(pow(r/3.7, 1.11) + 6.9/rey);
+            break;
+        case SWAMEE_JAIN:
+            x = -2.0*log10(r/3.7 + 5.74/pow(rey, 0.9));
+            break;
+        case SERGHIDES:
+            a = -2.0*log10(r/3.7 + 12.0/rey);
+            b = -2.0*log10(r/3.7 + 2.51*a/rey);
+            c = -2.0*log10(r/3.7 + 2.51*b/rey);
+            x = a - (b - a)*(b - a)/(c - 2.0*b + a);
+            break;
+        case ZIGRANG_SYLVESTER:
+            x = r/3.7 - 5.02/rey*log10(r/3.7 + 13.0/rey);
+            x = r/3.7 - 5.02/rey*log10(x);
+            x = -2.0*log10(x);
+            break;
+        default: //GOUDAR_SONNAD
+            gsA = 2.0/LN10;
+            gsB = r/3.7;
+            gsD = LN10*rey/5.02;
+            gsS = gsB*gsD + log(gsD);
+            gsQ = pow(gsS, gsS/(gsS + 1));
+            gsG = gsB*gsD + log(gsD/gsQ);
+            gsZ = log(gsQ/gsG);
+            gsDla = gsZ*gsG/(gsG + 1);
+            gsDcfa = gsDla*(1 + (gsZ/2)/((gsG + 1)*(gsG + 1) + (gsZ/3)*(2*gsG - 1)));
+            x = gsA*(log(gsD/gsQ) + gsDcfa);
+            break;
+    }
+
+    if(!(x > 1/sqrt(HAUT) && x < 1/sqrt(PRESQUE_0))) //aussi vrai si x n'est pas un nombre
+        return(IMPOSSIBLE);
+    return(1/(x*x));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixTable
+Paramtres :
+    tPtr - pointeur rfrant  la structure TABLE_FRICTION
+Valeur de retour :  void
+
+Description : Demande  l'utilisateur la densit de la table prcalcule. Une table
+de mme densit dj en mmoire est garde. Sinon, la table est projete depuis
+FICHIER_TABLE si ce fichier a la bonne densit, ou construite puis crite dans
+FICHIER_TABLE pour les prochains lancements. Affiche la taille de la table, le temps
+de prparation et l'erreur maximale d'interpolation.
+------------------------------------------------------------------------*/
+void choixTable(TABLE_FRICTION *tPtr)
+{
+    int noeuds; //nombre de noeuds par dcade
+    double debut; //temps au dbut de la construction
+
+    do
+    {
+        printf("Nombre de noeuds par d\202cade de la table (%d \205 %d) : ", TABLE_NOEUDS_MIN, TABLE_NOEUDS_MAX);
+        fflush(stdin);
+        scanf("%d", &noeuds);
+    }
+    while(noeuds < TABLE_NOEUDS_MIN || noeuds > TABLE_NOEUDS_MAX);
+
+    if(tPtr->xtbl != NULL && tPtr->noeudsParDecade == noeuds)
+        return;
+
+    debut = chrono();
+    if(lireTable(tPtr, noeuds) == VRAI)
+        printf("Table de %d x %d noeuds (%.1f Ko) projet\202e depuis %s en %.6f s.\n", tPtr->nbrRey, tPtr->nbrRug,
+               tPtr->nbrRey*tPtr->nbrRug*sizeof(double)/1024.0, FICHIER_TABLE, chrono() - debut);
+    else if(construireTable(tPtr, noeuds) == VRAI)
+    {
+        printf("Table de %d x %d noeuds (%.1f Ko) construite en %.3f s.\n", tPtr->nbrRey, tPtr->nbrRug,
+               tPtr->nbrRey*tPtr->nbrRug*sizeof(double)/1024.0, chrono() - debut);
+        if(ecrireTable(tPtr) == FAUX)
+            printf("Impossible d'\202crire la table dans %s.\n", FICHIER_TABLE);
+    }
+    else
+    {
+        printf("\nM\202moire insuffisante pour la table : la m\202thode de Newton sera utilis\202e.\n");
+        return;
+    }
+    printf("Domaine : %g <= Re <= %g, 0 <= eps/d <= %g. Erreur relative maximale : %.3e.\n",
+           (double)VALEUR_MIN_REY, TABLE_REY_MAX, TABLE_RUG_MAX, tPtr->erreurMax);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : construireTable
+Paramtres :
+    tPtr - pointeur rfrant  la structure TABLE_FRICTION
+    noeudsParDecade - nombre de noeuds par dcade selon chaque axe
+Valeur de retour :  VRAI si la table est construite, FAUX si la mmoire manque
+
+Description : Construit la table de x = 1/sqrt(f) sur une grille uniforme en
+u = log10(rey), de VALEUR_MIN_REY  TABLE_REY_MAX, et en v = log10(eps/d + TABLE_DECALAGE),
+de eps/d = 0  TABLE_RUG_MAX. Le dcalage rend la grille logarithmique pour les conduits
+rugueux tout en incluant les conduits lisses. x est interpol plutt que f, car il varie
+presque linairement avec u et v. Les noeuds sont calculs par colebrookDouble3(), sans
+test, puisque la racine existe partout dans le domaine. L'erreur de l'interpolation est
+ensuite mesure au centre de chaque cellule, l o l'interpolation est la plus loigne
+des noeuds, par rapport  colebrookLongDouble4(), et conserve dans tPtr->erreurMax.
+------------------------------------------------------------------------*/
+int construireTable(TABLE_FRICTION *tPtr, int noeudsParDecade)
+{
+    double rey, rug; //point courant
+    long double fExact; //solution de rfrence au centre d'une cellule
+    double erreur; //erreur relative au point courant
+    int i, j;
+
+    libererTable(tPtr);
+    tPtr->noeudsParDecade = noeudsParDecade;
+    tPtr->uMin = log10(VALEUR_MIN_REY);
+    tPtr->vMin = log10(TABLE_DECALAGE);
+    tPtr->nbrRey = (int)ceil((log10(TABLE_REY_MAX) - tPtr->uMin)*noeudsParDecade) + 1;
+    tPtr->nbrRug = (int)ceil((log10(TABLE_RUG_MAX + TABLE_DECALAGE) - tPtr->vMin)*noeudsParDecade) + 1;
+    tPtr->du = (log10(TABLE_REY_MAX) - tPtr->uMin)/(tPtr->nbrRey - 1);
+    tPtr->dv = (log10(TABLE_RUG_MAX + TABLE_DECALAGE) - tPtr->vMin)/(tPtr->nbrRug - 1);
+
+    tPtr->xtbl = malloc((size_t)tPtr->nbrRey*tPtr->nbrRug*sizeof(double));
+    if(tPtr->xtbl == NULL)
+        return(FAUX);
+
+    //noeuds de la grille : toutes les racines existent dans le domaine de la table
+    for(i = 0; i < tPtr->nbrRey; i = i + 1)
+    {
+        rey = (i == tPtr->nbrRey - 1) ? TABLE_REY_MAX : pow(10, tPtr->uMin + i*tPtr->du); //vite que l'arrondi sorte du domaine
+        for(j = 0; j < tPtr->nbrRug; j = j + 1)
+        {
+            rug = pow(10, tPtr->vMin + j*tPtr->dv) - TABLE_DECALAGE;
+            tPtr->xtbl[(long)i*tPtr->nbrRug + j] = 1/sqrt(colebrookDouble3(rey, rug));
+        }
+    }
+
+    //centres des cellules, compars  une rfrence plus prcise que double
+    tPtr->erreurMax = 0;
+    for(i = 0; i < tPtr->nbrRey - 1; i = i + 1)
+    {
+        rey = pow(10, tPtr->uMin + (i + 0.5)*tPtr->du);
+        for(j = 0; j < tPtr->nbrRug - 1; j = j + 1)
+        {
+            rug = pow(10, tPtr->vMin + (j + 0.5)*tPtr->dv) - TABLE_DECALAGE;
+            fExact = colebrookLongDouble4(rey, rug);
+            erreur = fabsl(interpolerTable(tPtr, rey, rug) - fExact)/fExact;
+            if(erreur > tPtr->erreurMax)
+                tPtr->erreurMax = erreur;
+        }
+    }
+    return(VRAI);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : interpolerTable
+Paramtres :
+    tPtr - pointeur rfrant  la structure TABLE_FRICTION
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+Valeur de retour :  f - facteur de friction interpol, ou IMPOSSIBLE hors du domaine
+
+Description : Interpolation bicubique (polynmes de Lagrange de degr 3 selon u et
+selon v) sur les 4 x 4 noeuds qui entourent le point. Prs des bords, le groupe de
+noeuds est dcal pour rester dans la table.
+------------------------------------------------------------------------*/
+double interpolerTable(TABLE_FRICTION *tPtr, double rey, double rugRel)
+{
+    double u, v; //position du point en units de pas de la grille
+    double poidsU[4], poidsV[4]; //poids de Lagrange selon u et v
+    double *ligne; //noeuds d'une ligne de la table
+    double x = 0; //valeur interpole de 1/sqrt(f)
+    int i, j; //premier noeud du groupe 4 x 4
+    int ix;
+
+    if(!(rey >= VALEUR_MIN_REY && rey <= TABLE_REY_MAX && rugRel >= 0 && rugRel <= TABLE_RUG_MAX))
+        return(IMPOSSIBLE);
+
+    u = (log10(rey) - tPtr->uMin)/tPtr->du;
+    v = (log10(rugRel + TABLE_DECALAGE) - tPtr->vMin)/tPtr->dv;
+    i = (int)u - 1;
+    if(i < 0)
+        i = 0;
+    else if(i > tPtr->nbrRey - 4)
+        i = tPtr->nbrRey - 4;
+    j = (int)v - 1;
+    if(j < 0)
+        j = 0;
+    else if(j > tPtr->nbrRug - 4)
+        j = tPtr->nbrRug - 4;
+
+    poidsLagrange(u - i - 1, poidsU);
+    poidsLagrange(v - j - 1, poidsV);
+    for(ix = 0; ix < 4; ix = ix + 1)
+    {
+        ligne = &tPtr->xtbl[(long)(i + ix)*tPtr->nbrRug + j];
+        x = x + poidsU[ix]*(poidsV[0]*ligne[0] + poidsV[1]*ligne[1] + poidsV[2]*ligne[2] + poidsV[3]*ligne[3]);
+    }
+    return(1/(x*x));
+}
+
+/*-----------------------------------------------------------------------
+Fonction : poidsLagrange
+Paramtres :
+    t - position du point par rapport au deuxime des quatre noeuds (0 <= t <= 1  l'intrieur)
+    poids - tableau o crire les 4 poids des noeuds -1, 0, 1 et 2
+Valeur de retour :  void
+
+Description : Poids de l'interpolation de Lagrange de degr 3 sur des noeuds quidistants.
+------------------------------------------------------------------------*/
+static inline void poidsLagrange(double t, double poids[])
+{
+    poids[0] = -t*(t - 1)*(t - 2)/6;
+    poids[1] = (t + 1)*(t - 1)*(t - 2)/2;
+    poids[2] = -(t + 1)*t*(t - 2)/2;
+    poids[3] = (t + 1)*t*(t - 1)/6;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : libererTable
+Paramtres :
+    tPtr - pointeur rfrant  la structure TABLE_FRICTION
+Valeur de retour :  void
+
+Description : Libre la mmoire de la table prcalcule, ou retire la projection
+du fichier si la table vient de FICHIER_TABLE.
+------------------------------------------------------------------------*/
+void libererTable(TABLE_FRICTION *tPtr)
+{
+    if(tPtr->projection != NULL)
+        libererProjection(tPtr->projection, tPtr->tailleProjection);
+    else
+        free(tPtr->xtbl);
+    tPtr->xtbl = NULL;
+    tPtr->projection = NULL;
+}
+
+/*-----------------------------------------------------------------------
+Fonction : ecrireTable
+Paramtres :
+    tPtr - pointeur rfrant  la structure TABLE_FRICTION
+Valeur de retour :  VRAI si la table est crite, FAUX sinon
+
+Description : crit l'en-tte et les valeurs de la table dans FICHIER_TABLE_TEMP, puis
+renomme ce fichier en FICHIER_TABLE. Un autre processus qui projette l'ancien fichier
+le garde donc intact, et aucun processus ne voit un fichier  moiti crit. Le nom du
+fichier temporaire contient le numro du processus, pour que deux processus qui crivent
+la table en mme temps ne tronquent pas le fichier l'un de l'autre.
+------------------------------------------------------------------------*/
+int ecrireTable(TABLE_FRICTION *tPtr)
+{
+    ENTETE_TABLE entete = {0};
+    FILE *fPtr;
+    char nomTemp[TAILLE_NOM_TEMP]; //fichier temporaire propre au processus
+    size_t n; //nombre de valeurs de la table
+    int ok; //drapeau
+
+    entete.magique = TABLE_MAGIQUE;
+    entete.version = TABLE_VERSION;
+    entete.noeudsParDecade = tPtr->noeudsParDecade;
+    entete.nbrRey = tPtr->nbrRey;
+    entete.nbrRug = tPtr->nbrRug;
+    entete.reyMin = VALEUR_MIN_REY;
+    entete.reyMax = TABLE_REY_MAX;
+    entete.rugMax = TABLE_RUG_MAX;
+    entete.decalage = TABLE_DECALAGE;
+    entete.uMin = tPtr->uMin;
+    entete.du = tPtr->du;
+    entete.vMin = tPtr->vMin;
+    entete.dv = tPtr->dv;
+    entete.erreurMax = tPtr->erreurMax;
+    n = (size_t)tPtr->nbrRey*tPtr->nbrRug;
+
+    sprintf(nomTemp, FICHIER_TABLE_TEMP, numeroProcessus());
+    fPtr = fopen(nomTemp, "wb");
+    if(fPtr == NULL)
+        return(FAUX);
+    ok = fwrite(&entete, sizeof(ENTETE_TABLE), 1, fPtr) == 1 && fwrite(tPtr->xtbl, sizeof(double), n, fPtr) == n;
+    if(fclose(fPtr) != 0)
+        ok = FAUX;
 
-    dPtr->estVide = FAUX; //la variable struct n'est plus vide
+#ifdef _WIN32
+    if(ok) //rename() ne remplace pas un fichier existant sous Windows
+        ok = MoveFileExA(nomTemp, FICHIER_TABLE, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    if(ok)
+        ok = rename(nomTemp, FICHIER_TABLE) == 0;
+#endif
+    if(!ok)
+        remove(nomTemp);
+    return(ok ? VRAI : FAUX);
+}
 
-    //vrifie que des facteurs de friction existent pour toute l'tendue et remplit tableaux si les valeurs sont valides
-    if(remplirTableaux(dPtr, tblPtr, fPtr) != IMPOSSIBLE)
-        demandeSauver(dPtr, tblPtr, fPtr);
+/*-----------------------------------------------------------------------
+Fonction : numeroProcessus
+Paramtres :
+    (aucun)
+Valeur de retour :  numro du processus courant
+
+Description : Donne le numro du processus, qui distingue les fichiers temporaires de
+processus lancs en mme temps dans le mme rpertoire.
+------------------------------------------------------------------------*/
+unsigned long numeroProcessus()
+{
+#ifdef _WIN32
+    return((unsigned long)GetCurrentProcessId());
+#else
+    return((unsigned long)getpid());
+#endif
 }
 
 /*-----------------------------------------------------------------------
-Fonction : invitation
+Fonction : lireTable
 Paramtres :
-    texte - chane de caractre qui corresond au nom de la variable que l'on demande de fournir.
-Valeur de retour :  valeur - valeur entre par l'utilisateur
+    tPtr - pointeur rfrant  la structure TABLE_FRICTION
+    noeudsParDecade - densit voulue
+Valeur de retour :  VRAI si la table est projete, FAUX si le fichier manque ou ne convient pas
 
-Description : Cette fonction demande  l'utilisisateur d'entrer une valeur. Retourne cette valeur  entrerDonnees()
-pour qu'elle soit affect  la variable approprie.
+Description : Projette FICHIER_TABLE en mmoire en lecture seule. Les valeurs sont
+lues directement dans la projection, sans copie : le temps de lancement ne dpend pas
+de la taille de la table, et les pages sont partages par tous les processus qui
+projettent le mme fichier. Le fichier est refus si l'identifiant, la version, le
+domaine, la densit ou la taille ne correspondent pas.
 ------------------------------------------------------------------------*/
-double invitation(char texte[])
+int lireTable(TABLE_FRICTION *tPtr, int noeudsParDecade)
 {
-    double valeur;
+    ENTETE_TABLE *entetePtr;
+    void *projection;
+    size_t taille; //taille du fichier
 
-    do
+    projection = projeterFichier(FICHIER_TABLE, &taille);
+    if(projection == NULL)
+        return(FAUX);
+
+    entetePtr = projection;
+    if(taille < sizeof(ENTETE_TABLE) || entetePtr->magique != TABLE_MAGIQUE || entetePtr->version != TABLE_VERSION
+       || entetePtr->noeudsParDecade != noeudsParDecade || entetePtr->reyMin != VALEUR_MIN_REY
+       || entetePtr->reyMax != TABLE_REY_MAX || entetePtr->rugMax != TABLE_RUG_MAX || entetePtr->decalage != TABLE_DECALAGE
+       || entetePtr->nbrRey < 4 || entetePtr->nbrRug < 4
+       || taille != sizeof(ENTETE_TABLE) + (size_t)entetePtr->nbrRey*entetePtr->nbrRug*sizeof(double))
     {
-        printf("\nVeuillez entrer la valeur pour %s : ", texte);
-        fflush(stdin);
-        scanf("%lf", &valeur);
+        libererProjection(projection, taille);
+        return(FAUX);
     }
-    while(!getValeurPositive(valeur)); //rpte si valeur ngative
 
-    return(valeur);
+    libererTable(tPtr);
+    tPtr->noeudsParDecade = entetePtr->noeudsParDecade;
+    tPtr->nbrRey = entetePtr->nbrRey;
+    tPtr->nbrRug = entetePtr->nbrRug;
+    tPtr->uMin = entetePtr->uMin;
+    tPtr->du = entetePtr->du;
+    tPtr->vMin = entetePtr->vMin;
+    tPtr->dv = entetePtr->dv;
+    tPtr->erreurMax = entetePtr->erreurMax;
+    tPtr->xtbl = (double *)(entetePtr + 1);
+    tPtr->projection = projection;
+    tPtr->tailleProjection = taille;
+    return(VRAI);
 }
 
 /*-----------------------------------------------------------------------
-Fonction : demandeSauver
+Fonction : projeterFichier
 Paramtres :
-    dPtr - pointeur rfrant  la structure DONNEES
-    tblPtr - pointeur rfrant le tableau de type DONNEES
-    fPtr - pointeur rfrant  la structure FILE
-Valeur de retour :  void
+    nom - nom du fichier
+    taillePtr - pointeur o crire la taille du fichier
+Valeur de retour :  adresse de la projection, ou NULL si impossible
 
-Description : Cette fonction demande  l'utilisateur s'il veut sauvegarder ses donnes. Si oui,
-fait appel  sauverDonnees; si non, rpte la demande.
+Description : Projette un fichier complet en mmoire, en lecture seule, avec
+CreateFileMapping() sous Windows et mmap() ailleurs.
 ------------------------------------------------------------------------*/
-void demandeSauver(DONNEES *dPtr, DONNEES *tblPtr, FILE *fPtr)
+void *projeterFichier(char nom[], size_t *taillePtr)
 {
-    char reponse; //rponse de l'utilisateur
-    printf("\n\nVoulez-vous sauver vos donn\202es?");
-    printf("\nR\202pondre 'o' pour oui et 'n' pour non : ");
-    fflush(stdin);
-    scanf("%c", &reponse);
-    while(reponse != 'o' && reponse != 'n')//s'assure que l'utilisateur entre un caractre valide
+    void *projection = NULL;
+#ifdef _WIN32
+    HANDLE fichier, objet;
+    LARGE_INTEGER taille;
+
+    fichier = CreateFileA(nom, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(fichier == INVALID_HANDLE_VALUE)
+        return(NULL);
+    if(GetFileSizeEx(fichier, &taille) && taille.QuadPart > 0)
     {
-        printf(" - ERREUR! Le caract\212re n'est pas valide. S.V.P r\202pondre 'o' ou 'n' : ");
-        fflush(stdin);
-        scanf("%c", &reponse);
+        objet = CreateFileMappingA(fichier, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(objet != NULL)
+        {
+            projection = MapViewOfFile(objet, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(objet); //la vue garde la projection ouverte
+        }
+        *taillePtr = (size_t)taille.QuadPart;
     }
-    if(reponse == 'o')
-        sauverDonnees(dPtr, tblPtr, fPtr); //sauve les donnes
+    CloseHandle(fichier);
+#else
+    int fichier;
+    struct stat infos;
+
+    fichier = open(nom, O_RDONLY);
+    if(fichier < 0)
+        return(NULL);
+    if(fstat(fichier, &infos) == 0 && infos.st_size > 0)
+    {
+        projection = mmap(NULL, (size_t)infos.st_size, PROT_READ, MAP_SHARED, fichier, 0);
+        if(projection == MAP_FAILED)
+            projection = NULL;
+        *taillePtr = (size_t)infos.st_size;
+    }
+    close(fichier); //la projection reste valide
+#endif
+    return(projection);
 }
 
-/*------------
-Fonction :  sauverDonnees
+/*-----------------------------------------------------------------------
+Fonction : libererProjection
+Paramtres :
+    projection - adresse retourne par projeterFichier()
+    taille - taille du fichier projet
+Valeur de retour :  void
 
-Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
-                tblPtr - pointeur rfrant le tableau de type DONNEES
-                fPtr - pointeur rfrant  la structure FILE
+Description : Retire la projection d'un fichier.
+------------------------------------------------------------------------*/
+void libererProjection(void *projection, size_t taille)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(projection);
+#else
+    munmap(projection, taille);
+#endif
+}
+
+/*-----------------------------------------------------------------------
+Fonction : choixSubstitut
+Paramtres :
+    sPtr - pointeur rfrant  la structure SUBSTITUT
 Valeur de retour :  void
 
-Description :   Cette fonction sauvegarde les donnes de l'utilisateur dans le premier espace vide
- l'intrieur du fichier binaire. Si il n'y a pas d'espace vide dans le fichier, la
-fonction fait appel  afficheDonnees. Ensuite, la fonction demande  l'utilisateur
-quel membre qu'il veut remplacer et sauve ses donnes  ce membre.
-------------*/
-void sauverDonnees(DONNEES *dPtr, DONNEES tblPtr[], FILE *fPtr)
+Description : Demande  l'utilisateur le domaine du substitut de Tchebychev, l'ajuste,
+puis le valide. Affiche le temps d'ajustement, le dbit d'valuation du substitut et
+de la mthode de Newton, ainsi que l'erreur maximale, afin de juger si le substitut
+vaut la peine pour le calcul  faire.
+------------------------------------------------------------------------*/
+void choixSubstitut(SUBSTITUT *sPtr)
 {
-    int ix; // Index pour la boucle
-    int ixVide = -1; // Pour l'index du tableau du 1er membre vide retrouv par la boucle
-    int choix; // Choix pour le numro du membre  remplacer
+    double debut; //temps au dbut de l'ajustement
+    double debitSubstitut, debitNewton; //valuations par seconde
 
-    for(ix = 0; ix < NBR_SAUVER && ixVide == -1; ix = ix +1)
+    do
     {
-        if(tblPtr[ix].estVide == VRAI) //si c'est vide, sauve les donnees dans le premier membre vide
-        {
-            tblPtr[ix] = *dPtr;
-            ixVide = ix;
-        }
+        sPtr->reyMin = invitation("le nombre de Reynolds minimal du substitut");
+        sPtr->reyMax = invitation("le nombre de Reynolds maximal du substitut");
+        sPtr->rugMin = invitation("la rugosit\202 relative eps/d minimale du substitut");
+        sPtr->rugMax = invitation("la rugosit\202 relative eps/d maximale du substitut");
+        if(sPtr->reyMin < VALEUR_MIN_REY || sPtr->reyMax <= sPtr->reyMin || sPtr->rugMax <= sPtr->rugMin)
+            printf(" - ERREUR! Il faut %d <= Re min < Re max et eps/d min < eps/d max.", VALEUR_MIN_REY);
     }
-    if(ixVide == -1) //aucun membre vide trouv
+    while(sPtr->reyMin < VALEUR_MIN_REY || sPtr->reyMax <= sPtr->reyMin || sPtr->rugMax <= sPtr->rugMin);
+
+    debut = chrono();
+    if(ajusterSubstitut(sPtr) == FAUX)
     {
-        afficheDonnees(tblPtr);
-        printf("Le fichier est plein. \nS.V.P. choisir le membre que vous voulez remplacer par vos donn\202es (1-5) : ");
-        fflush(stdin);
-        scanf("%d", &choix);
-        ix = choix;
-        tblPtr[ix-1] = *dPtr;
+        printf("\nLe substitut ne peut pas \210tre ajust\202 (m\202moire insuffisante ou aucune racine dans le domaine) : la m\202thode de Newton sera utilis\202e.\n");
+        return;
     }
-    ecrireFichier(tblPtr, fPtr); //sauve dans le fichier
-    printf("\nVos donn\202es ont \202t\202 sauv\202es dans le membre %d du fichier.", ix);
+    printf("\nSubstitut de %d x %d morceaux de degr\202 %d ajust\202 en %.3f s.\n", sPtr->nbrU, sPtr->nbrV, DEGRE_CHEB, chrono() - debut);
 
+    sPtr->erreurMax = validerSubstitut(sPtr, &debitSubstitut, &debitNewton);
+    if(sPtr->erreurMax < 0)
+    {
+        printf("M\202moire insuffisante pour la validation du substitut.\n");
+        return;
+    }
+    printf("Validation sur %d points : erreur relative maximale %.3e.\n", NBR_VALIDATION, sPtr->erreurMax);
+    printf("D\202bit : %.1f millions d'\202valuations/s pour le substitut, %.1f millions/s pour Newton.\n",
+           debitSubstitut/1E6, debitNewton/1E6);
 }
 
-/*------------
-Fonction :  verifieDiam
-
-Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
-Valeur de retour :  bonDiam - VRAI si diamtres sont valides, FAUX autrement
+/*-----------------------------------------------------------------------
+Fonction : ajusterSubstitut
+Paramtres :
+    sPtr - pointeur rfrant  la structure SUBSTITUT (domaine dj choisi)
+Valeur de retour :  VRAI si le substitut est ajust, FAUX sinon
 
-Description :   Cette fonction vrifie les valeurs de dmax et de dmin
-sont valides (dmax > dmin). Affiche message si les donnes sont invalides.
-------------*/
-int verifieDiam(DONNEES *dPtr)
+Description : Ajuste un polynme de Tchebychev de degr DEGRE_CHEB en u et en v sur
+chaque morceau du domaine, un morceau par dcade (ou moins) selon chaque axe. x = 1/sqrt(f)
+est calcul par calculFrictionLot() aux noeuds de Tchebychev t_k = cos(pi*(k + 1/2)/N),
+N = NBR_COEF_CHEB, de tous les morceaux  la fois. Les coefficients de l'interpolant sont
+obtenus par la transforme en cosinus discrte des valeurs aux noeuds :
+    c_ij = (2 - [i = 0])*(2 - [j = 0])/N^2 * somme_k somme_l x_kl*cos(pi*i*(k + 1/2)/N)*cos(pi*j*(l + 1/2)/N)
+Les coefficients du morceau m sont rangs  coef[m*N*N + j*N + i], j tant le degr
+en v, ce que demande evaluerSubstitut().
+------------------------------------------------------------------------*/
+int ajusterSubstitut(SUBSTITUT *sPtr)
 {
-    int bonDiam = VRAI; //drapeau
-    if(dPtr->dmax <= dPtr->dmin) //diamtres invalides
+    OPTIONS options; //options du calcul des noeuds
+    double *rey, *rug, *f; //entres et sorties du calcul par lot
+    int *statut; //statut de chaque noeud
+    double cosTbl[NBR_COEF_CHEB][NBR_COEF_CHEB]; //cos(pi*i*(k + 1/2)/N)
+    double t[NBR_COEF_CHEB]; //noeuds de Tchebychev dans [-1, 1]
+    double temp[NBR_COEF_CHEB][NBR_COEF_CHEB]; //transforme selon v
+    double *x; //valeurs aux noeuds d'un morceau
+    double *c; //coefficients d'un morceau
+    double somme;
+    long n; //nombre de noeuds
+    long m; //numro du morceau
+    int i, j, k, l;
+    int ok = VRAI; //drapeau
+
+    libererSubstitut(sPtr);
+    sPtr->uMin = log10(sPtr->reyMin);
+    sPtr->vMin = log10(sPtr->rugMin + TABLE_DECALAGE);
+    sPtr->nbrU = (int)ceil(log10(sPtr->reyMax) - sPtr->uMin);
+    sPtr->nbrV = (int)ceil(log10(sPtr->rugMax + TABLE_DECALAGE) - sPtr->vMin);
+    if(sPtr->nbrU < 1)
+        sPtr->nbrU = 1;
+    if(sPtr->nbrV < 1)
+        sPtr->nbrV = 1;
+    sPtr->du = (log10(sPtr->reyMax) - sPtr->uMin)/sPtr->nbrU;
+    sPtr->dv = (log10(sPtr->rugMax + TABLE_DECALAGE) - sPtr->vMin)/sPtr->nbrV;
+
+    n = (long)sPtr->nbrU*sPtr->nbrV*NBR_COEF_CHEB*NBR_COEF_CHEB;
+    sPtr->coef = malloc(n*sizeof(double));
+    rey = malloc(n*sizeof(double));
+    rug = malloc(n*sizeof(double));
+    f = malloc(n*sizeof(double));
+    statut = malloc(n*sizeof(int));
+    if(sPtr->coef == NULL || rey == NULL || rug == NULL || f == NULL || statut == NULL)
+        ok = FAUX;
+
+    for(k = 0; k < NBR_COEF_CHEB; k = k + 1)
     {
-        printf(" - ERREUR! Les valeurs du diam\212tre maximal et du diam\212tre minimal sont invalides.");
-        printf("\n - S.V.P. entrez des valeurs telles que le diam\212tre maximal est plus grand que le diam\212tre minimal.\n");
-        bonDiam = FAUX;
+        t[k] = cos(M_PI*(k + 0.5)/NBR_COEF_CHEB);
+        for(i = 0; i < NBR_COEF_CHEB; i = i + 1)
+            cosTbl[i][k] = cos(M_PI*i*(k + 0.5)/NBR_COEF_CHEB);
     }
-    return(bonDiam);
-}
-
-/*------------
-Fonction :  getValeurPositive
 
-Paramtres :    valeur - valeur envoye par entrerDonnees
-Valeur de retour :  int (VRAI ou FAUX)
+    //noeuds de tous les morceaux, x_kl du morceau m  l'indice m*N*N + k*N + l
+    for(m = 0; m < (long)sPtr->nbrU*sPtr->nbrV && ok == VRAI; m = m + 1)
+        for(k = 0; k < NBR_COEF_CHEB; k = k + 1)
+            for(l = 0; l < NBR_COEF_CHEB; l = l + 1)
+            {
+                rey[(m*NBR_COEF_CHEB + k)*NBR_COEF_CHEB + l] = pow(10, sPtr->uMin + (m/sPtr->nbrV + (t[k] + 1)/2)*sPtr->du);
+                rug[(m*NBR_COEF_CHEB + k)*NBR_COEF_CHEB + l] = pow(10, sPtr->vMin + (m%sPtr->nbrV + (t[l] + 1)/2)*sPtr->dv) - TABLE_DECALAGE;
+            }
+    if(ok == VRAI)
+    {
+        initOptions(&options);
+        options.methode = NEWTON;
+        if(calculFrictionLot(rey, rug, f, statut, n, &options) != n) //une racine manque dans le domaine
+            ok = FAUX;
+    }
 
-Description :   Cette fonction vrifie si les valeurs sont valides ( > 0 ). La
-fonction affiche un message si les valeurs sont invalides et retourne FAUX,
-sinon retourne VRAI.
-------------*/
-int getValeurPositive(double valeur)
-{
-    if (valeur < 0)
+    for(m = 0; m < (long)sPtr->nbrU*sPtr->nbrV && ok == VRAI; m = m + 1)
     {
-        printf(" - ERREUR! La valeur fournie n'est pas valide. Elle doit \210tre plus grande que z\202ro.");
+        x = &f[m*NBR_COEF_CHEB*NBR_COEF_CHEB];
+        c = &sPtr->coef[m*NBR_COEF_CHEB*NBR_COEF_CHEB];
+        for(k = 0; k < NBR_COEF_CHEB*NBR_COEF_CHEB; k = k + 1)
+            x[k] = 1/sqrt(x[k]);
 
-        return(FAUX);
+        for(k = 0; k < NBR_COEF_CHEB; k = k + 1) //transforme selon v
+            for(j = 0; j < NBR_COEF_CHEB; j = j + 1)
+            {
+                somme = 0;
+                for(l = 0; l < NBR_COEF_CHEB; l = l + 1)
+                    somme = somme + x[k*NBR_COEF_CHEB + l]*cosTbl[j][l];
+                temp[k][j] = somme;
+            }
+        for(i = 0; i < NBR_COEF_CHEB; i = i + 1) //transforme selon u
+            for(j = 0; j < NBR_COEF_CHEB; j = j + 1)
+            {
+                somme = 0;
+                for(k = 0; k < NBR_COEF_CHEB; k = k + 1)
+                    somme = somme + temp[k][j]*cosTbl[i][k];
+                c[j*NBR_COEF_CHEB + i] = somme*(i == 0 ? 1 : 2)*(j == 0 ? 1 : 2)/(NBR_COEF_CHEB*NBR_COEF_CHEB);
+            }
     }
-    return(VRAI);
-}
 
-/*------------
-Fonction :  calculerRey
+    free(rey);
+    free(rug);
+    free(f);
+    free(statut);
+    if(ok == FAUX)
+        libererSubstitut(sPtr);
+    return(ok);
+}
 
-Paramtres :    dPtr - pointeur rfrant  la structure DONNEES
-Valeur de retour :  int (VRAI ou FAUX)
+/*-----------------------------------------------------------------------
+Fonction : evaluerSubstitut
+Paramtres :
+    sPtr - pointeur rfrant  la structure SUBSTITUT
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+Valeur de retour :  f - facteur de friction du substitut, ou IMPOSSIBLE hors du domaine
 
-Description :   Cette fonction calcule le nombre de Reynolds et vrifie si ce nombre est valide
-( > VALEUR_MIN_REY ). Si le nombre de Reynolds est plus petit que 4000, la fonction
-affiche un message que la valeur n'est pas valide et retourne FAUX. Sinon, retourne VRAI.
-------------*/
-int calculerRey(DONNEES *dPtr)
+Description : value le substitut par l'algorithme de Clenshaw. La rcurrence selon v
+est faite pour les N lignes de coefficients  la fois : la boucle interne parcourt des
+coefficients contigus sans dpendance entre les lignes, et peut donc tre vectorise
+par le compilateur. Une dernire rcurrence de Clenshaw selon u donne x = 1/sqrt(f).
+------------------------------------------------------------------------*/
+double evaluerSubstitut(SUBSTITUT *sPtr, double rey, double rugRel)
 {
-    //calcul de la vitesse
-    dPtr->vit = pow((0.5*dPtr->dmax), 2); /*Diamtre maximal donnera la vitesse minimale,
-                                            qui donnera le nombre de Reynolds minimal qu'atteint
-                                            la fonction*/
-    dPtr->vit = dPtr->vit * M_PI;
-    dPtr->vit = dPtr->debit / dPtr->vit;
+    double u, v; //position dans le domaine, en largeurs de morceau
+    double tu, tv; //position dans le morceau, entre -1 et 1
+    double b1[NBR_COEF_CHEB] = {0}, b2[NBR_COEF_CHEB] = {0}; //rcurrence selon v pour chaque ligne
+    double temp;
+    double a1 = 0, a2 = 0; //rcurrence selon u
+    double *c; //coefficients du morceau
+    int mu, mv; //morceau selon u et v
+    int i, j;
 
-    //calcul du nombre de Reynolds
-    dPtr->rey = dPtr->ro * dPtr->vit * dPtr->dmax;
-    dPtr->rey = dPtr->rey / dPtr->mu;
+    if(!(rey >= sPtr->reyMin && rey <= sPtr->reyMax && rugRel >= sPtr->rugMin && rugRel <= sPtr->rugMax))
+        return(IMPOSSIBLE);
 
-    if(dPtr->rey < VALEUR_MIN_REY) //Reynold < 4000
+    u = (log10(rey) - sPtr->uMin)/sPtr->du;
+    v = (log10(rugRel + TABLE_DECALAGE) - sPtr->vMin)/sPtr->dv;
+    mu = (int)u;
+    if(mu > sPtr->nbrU - 1)
+        mu = sPtr->nbrU - 1;
+    mv = (int)v;
+    if(mv > sPtr->nbrV - 1)
+        mv = sPtr->nbrV - 1;
+    tu = 2*(u - mu) - 1;
+    tv = 2*(v - mv) - 1;
+    c = &sPtr->coef[((long)mu*sPtr->nbrV + mv)*NBR_COEF_CHEB*NBR_COEF_CHEB];
+
+    for(j = DEGRE_CHEB; j >= 1; j = j - 1)
+        for(i = 0; i < NBR_COEF_CHEB; i = i + 1)
+        {
+            temp = b1[i];
+            b1[i] = 2*tv*b1[i] - b2[i] + c[j*NBR_COEF_CHEB + i];
+            b2[i] = temp;
+        }
+    for(i = DEGRE_CHEB; i >= 1; i = i - 1) //b1[i] devient le coefficient de T_i(tu)
     {
-        printf("\nLa valeur obtenue pour le nombre de Reynolds, soit %.4f, n'est pas valide car elle est plus petite que 4000.", dPtr->rey);
-        printf("\nVous devez entrer vos valeurs de nouveau afin que le nombre de Reynolds soit plus grand que 4000.");
-        return(FAUX);
+        temp = a1;
+        a1 = 2*tu*a1 - a2 + (tv*b1[i] - b2[i] + c[i]);
+        a2 = temp;
     }
-    return(VRAI);
+    u = tu*a1 - a2 + (tv*b1[0] - b2[0] + c[0]); //x = 1/sqrt(f)
+
+    return(1/(u*u));
 }
 
 /*-----------------------------------------------------------------------
-Fonction : remplirTableaux
+Fonction : evaluerSubstitutLot
 Paramtres :
-    dPtr - pointeur rfrant  la structure de donnes.
-    tblPtr - pointeur rfrant le tableau de type DONNEES
-    fPtr - pointeur rfrant  la structure FILE
-Valeur de retour :  IMPOSSIBLE si valeurs impossibles, ou 0 si le tout est acceptable
+    sPtr - pointeur rfrant  la structure SUBSTITUT
+    rey - tableau des nombres de Reynolds
+    rugRel - tableau des rugosits relatives eps/d
+    f - tableau o crire les facteurs de friction (IMPOSSIBLE hors du domaine)
+    n - nombre d'lments des tableaux
+Valeur de retour :  void
 
-Description : Cette fonction remplit les tableaux du diamtre et
-du facteur de friction. Les valeurs sont calcules  l'aide de la
-fonction calculFriction(). Ces tableaux seront utilises pour le graphique.
+Description : value le substitut pour des tableaux contigus de points.
 ------------------------------------------------------------------------*/
-int remplirTableaux(DONNEES *dPtr, DONNEES tblPtr[], FILE *fPtr)
+void evaluerSubstitutLot(SUBSTITUT *sPtr, const double rey[], const double rugRel[], double f[], long n)
 {
-    double dtemp; //stocker diamtres intermdiaires
-    int ix;
-    double inc;//valeur pour incrmenter le diamtre
-    int impossible = FAUX; //valeurs irrelles (drapeau)
+    long ix;
 
-    dtemp = dPtr->dmin;
+    for(ix = 0; ix < n; ix = ix + 1)
+        f[ix] = evaluerSubstitut(sPtr, rey[ix], rugRel[ix]);
+}
 
-    inc = (dPtr->dmax - dPtr->dmin)/(TAILLE_MAX-1);
+/*-----------------------------------------------------------------------
+Fonction : validerSubstitut
+Paramtres :
+    sPtr - pointeur rfrant  la structure SUBSTITUT
+    debitSubstitutPtr - pointeur o crire le nombre d'valuations par seconde du substitut
+    debitNewtonPtr - pointeur o crire le nombre d'valuations par seconde de Newton
+Valeur de retour :  erreurMax - erreur relative maximale de f, ou -1 si la mmoire manque
 
-    //calcul les valeurs de friction et remplit les tableaux
-    for(ix = 0; ix < TAILLE_MAX && impossible == FAUX; ix = ix +1)
-    {
-        dPtr->dtbl[ix] = dtemp;
-        dPtr->ftbl[ix] = calculFriction(dPtr, dtemp, tblPtr, fPtr);
+Description : Compare le substitut  la mthode de Newton sur NBR_VALIDATION points
+tirs au hasard, uniformment en u et en v, dans le domaine. Chaque calcul est
+chronomtr sur le mme ensemble de points.
+------------------------------------------------------------------------*/
+double validerSubstitut(SUBSTITUT *sPtr, double *debitSubstitutPtr, double *debitNewtonPtr)
+{
+    OPTIONS options; //options de la mthode de Newton
+    double *rey, *rug, *fExact, *fSubstitut;
+    int *statut;
+    double uMax, vMax; //coin suprieur du domaine
+    double debut; //temps au dbut d'un calcul
+    double erreur, erreurMax = 0;
+    long ix;
 
-        if(dPtr->ftbl[ix] < 0) //vrifie si facteur de friction existe
-            impossible = VRAI;
+    rey = malloc(NBR_VALIDATION*sizeof(double));
+    rug = malloc(NBR_VALIDATION*sizeof(double));
+    fExact = malloc(NBR_VALIDATION*sizeof(double));
+    fSubstitut = malloc(NBR_VALIDATION*sizeof(double));
+    statut = malloc(NBR_VALIDATION*sizeof(int));
+    if(rey == NULL || rug == NULL || fExact == NULL || fSubstitut == NULL || statut == NULL)
+        erreurMax = -1;
 
-        dtemp = dtemp + inc;
+    uMax = log10(sPtr->reyMax);
+    vMax = log10(sPtr->rugMax + TABLE_DECALAGE);
+    srand(1); //mme ensemble de validation  chaque fois
+    for(ix = 0; ix < NBR_VALIDATION && erreurMax == 0; ix = ix + 1)
+    {
+        rey[ix] = pow(10, sPtr->uMin + (uMax - sPtr->uMin)*rand()/RAND_MAX);
+        rug[ix] = pow(10, sPtr->vMin + (vMax - sPtr->vMin)*rand()/RAND_MAX) - TABLE_DECALAGE;
+        if(rey[ix] > sPtr->reyMax) //arrondi de pow()
+            rey[ix] = sPtr->reyMax;
+        if(rug[ix] < sPtr->rugMin)
+            rug[ix] = sPtr->rugMin;
+        else if(rug[ix] > sPtr->rugMax)
+            rug[ix] = sPtr->rugMax;
     }
-    if(impossible == VRAI)//si facteurs de frictions impossibles, redemande des donnes
+
+    if(erreurMax == 0)
     {
-        obtientDonnees(dPtr, tblPtr, fPtr);
-        return(IMPOSSIBLE);
+        initOptions(&options);
+        options.methode = NEWTON;
+        debut = chrono();
+        calculFrictionLot(rey, rug, fExact, statut, NBR_VALIDATION, &options);
+        *debitNewtonPtr = NBR_VALIDATION/(chrono() - debut);
+
+        debut = chrono();
+        evaluerSubstitutLot(sPtr, rey, rug, fSubstitut, NBR_VALIDATION);
+        *debitSubstitutPtr = NBR_VALIDATION/(chrono() - debut);
+
+        for(ix = 0; ix < NBR_VALIDATION; ix = ix + 1)
+        {
+            erreur = fabs(fSubstitut[ix] - fExact[ix])/fExact[ix];
+            if(erreur > erreurMax)
+                erreurMax = erreur;
+        }
     }
-    return(0);
+
+    free(rey);
+    free(rug);
+    free(fExact);
+    free(fSubstitut);
+    free(statut);
+    return(erreurMax);
 }
 
 /*-----------------------------------------------------------------------
-Fonction : calculFriction
+Fonction : libererSubstitut
 Paramtres :
-    dPtr - pointeur rfrant  la structure de donnes.
-    d - variable du diamtre  calculer afin de dterminer le facteur de friction.
-    tblPtr - pointeur rfrant le tableau de type DONNEES
-    fPtr - pointeur rfrant  la structure FILE
-Valeur de retour :  temp - valeur de la racine trouve
+    sPtr - pointeur rfrant  la structure SUBSTITUT
+Valeur de retour :  void
 
-Description : Cette fonction utilise la mthode de bissection et la fonction calculColebrook()
-afin de trouver la valeur du facteur de friction pour le diamtre donn.
+Description : Libre les coefficients du substitut de Tchebychev.
 ------------------------------------------------------------------------*/
-double calculFriction(DONNEES *dPtr, double d, DONNEES tblPtr[], FILE *fPtr)
+void libererSubstitut(SUBSTITUT *sPtr)
 {
-    double haut, bas, temp;
+    free(sPtr->coef);
+    sPtr->coef = NULL;
+}
 
-    haut = HAUT; //borne suprieure
-    bas = PRESQUE_0; //borne infrieure
-    temp = (haut+bas)/2; //borne du milieu
+/*-----------------------------------------------------------------------
+Fonction : afficheErreurExplicite
+Paramtres :
+    dPtr - pointeur rfrant  la structure de donnes.
+    optPtr - pointeur rfrant  la structure OPTIONS
+Valeur de retour :  void
+
+Description : Compare les facteurs de friction obtenus par la corrlation explicite
+(ou par Newton en simple prcision) avec la solution de Colebrook obtenue par la
+mthode de Newton en double prcision, pour tous les diamtres
+du tableau. Affiche l'erreur relative maximale et avertit si elle dpasse SEUIL_ERREUR.
+------------------------------------------------------------------------*/
+void afficheErreurExplicite(DONNEES *dPtr, OPTIONS *optPtr)
+{
+    int ix;
+    long nbrEval; //valuations utilises par Newton (non utilis)
+    double fExact; //solution de Colebrook
+    double erreur; //erreur relative au point courant
+    double erreurMax = 0; //erreur relative maximale
+    double dErreurMax = dPtr->dtbl[0]; //diamtre o l'erreur est maximale
+    CRITERE critere; //critre par dfaut pour la rfrence, quel que soit celui de l'utilisateur
 
-    if(calculColebrook(haut, d, dPtr)*calculColebrook(bas, d, dPtr) < 0) //si racine existe
+    initCritere(&critere);
+    for(ix = 0; ix < dPtr->nbrPoints; ix = ix + 1)
     {
-        //tant et autant que le produit des facteurs de friction aux bornes est plus grand que la tolrance
-        //si le facteur de friction  temp = 0, c'est la racine
-        while(fabs(calculColebrook(haut, d, dPtr)*calculColebrook(bas, d, dPtr)) > TOLERANCE && calculColebrook(temp, d, dPtr) != 0)
+        fExact = calculNewton(reyPoint(dPtr, optPtr, dPtr->dtbl[ix]), dPtr->eps/dPtr->dtbl[ix], &nbrEval, 0, &critere);
+        erreur = fabs(dPtr->ftbl[ix] - fExact)/fExact;
+        if(erreur > erreurMax)
         {
-            if(calculColebrook(haut, d, dPtr)*calculColebrook(temp, d, dPtr) < 0) //si racine est dans demi suprieure
-                bas = temp;
-            else if(calculColebrook(bas, d, dPtr)*calculColebrook(temp, d, dPtr) < 0) //si racine est dans demi infrieur
-                haut = temp;
-
-            temp = (haut+bas)/2; //affecte la nouvelle valeur du mileu
+            erreurMax = erreur;
+            dErreurMax = dPtr->dtbl[ix];
         }
     }
-    else //si il n'a pas de racine
+
+    printf("\nErreur relative maximale de %s%s%s par rapport \205 Colebrook : %.3e (%g %%), au diam\212tre %g m.",
+           nomMethode(optPtr->methode), optPtr->methode == NEWTON ? " en " : "", optPtr->methode == NEWTON ? nomPrecision(precisionNewton(optPtr)) : "",
+           erreurMax, 100*erreurMax, dErreurMax);
+    if(erreurMax > SEUIL_ERREUR)
+        printf("\nAttention! L'erreur d\202passe %g %% : utilisez plut\223t une m\202thode it\202rative.", 100*SEUIL_ERREUR);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : nomMethode
+Paramtres :
+    methode - numro de la mthode de rsolution
+Valeur de retour :  nom - chane de caractres qui dcrit la mthode
+
+Description : Retourne le nom de la mthode de rsolution, pour l'affichage.
+------------------------------------------------------------------------*/
+char *nomMethode(int methode)
+{
+    char *nom;
+
+    switch(methode)
     {
-        printf("\n\nLes donn\202es entr\202es sont irr\202alistes! \nDes facteurs de frictions n'existent pas pour tout l'\202tendue des diam\212tres donn\202e.");
-        printf("\nVous devez utiliser des donn\202es r\202alistes.\n");
-        temp = IMPOSSIBLE;// valeur de -1
+        case BISSECTION:        nom = "bissection"; break;
+        case NEWTON:            nom = "Newton-Raphson"; break;
+        case OMEGA_WRIGHT:      nom = "om\202ga de Wright"; break;
+        case HAALAND:           nom = "Haaland"; break;
+        case SWAMEE_JAIN:       nom = "Swamee-Jain"; break;
+        case SERGHIDES:         nom = "Serghides"; break;
+        case ZIGRANG_SYLVESTER: nom = "Zigrang-Sylvester"; break;
+        case GOUDAR_SONNAD:     nom = "Goudar-Sonnad"; break;
+        case TABLE_BICUBIQUE:   nom = "table bicubique"; break;
+        default:                nom = "substitut de Tchebychev"; break;
     }
-    return(temp);
+    return(nom);
 }
 
 /*-----------------------------------------------------------------------
 Fonction : calculColebrook
 Paramtres :
     f - facteur de friction dans la formule Colebrook, correspond  haut, temp, ou bas
-	d - diamtre actuel du conduit pour trouver le facteur de friction
-	dPtr - pointeur rfrant  la structure DONNEES
+	rey - nombre de Reynolds
+	rugRel - rugosit relative eps/d du conduit
 Valeur de retour :  g_de_f - valeur calcule par lquation Colebrook
 
 Description : Cette fonction calcule g en fonction de f, g(f) dans la formule,
  l'aide de l'quation Colebrook.
 ------------------------------------------------------------------------*/
-double calculColebrook(double f, double d, DONNEES *dPtr)
+double calculColebrook(double f, double rey, double rugRel)
 {
     double g_de_f; //valeur finale
 
-    g_de_f = dPtr->eps/(3.7*d) + 2.51/(dPtr->rey * sqrt(f));
+    g_de_f = rugRel/3.7 + 2.51/(rey * sqrt(f));
     g_de_f = 2.0*log10(g_de_f);
     g_de_f = 1/sqrt(f) + g_de_f; //accumulation
 
     return(g_de_f);
 }
 
+/*-----------------------------------------------------------------------
+Fonction : calculColebrookX
+Paramtres :
+    x - inverse de la racine du facteur de friction, x = 1/sqrt(f)
+    rey - nombre de Reynolds
+    rugRel - rugosit relative eps/d du conduit
+    gPrimePtr - pointeur o crire la drive dg/dx
+Valeur de retour :  g_de_x - valeur calcule par lquation Colebrook
+
+Description : Cette fonction calcule l'quation Colebrook crite en fonction de x,
+g(x) = x + 2*log10(eps/(3.7*d) + 2.51*x/rey), ainsi que sa drive analytique
+g'(x) = 1 + 2*(2.51/rey)/(ln(10)*(eps/(3.7*d) + 2.51*x/rey)). g(1/sqrt(f)) est
+gale  calculColebrook(f), mais sans racine carre.
+------------------------------------------------------------------------*/
+double calculColebrookX(double x, double rey, double rugRel, double *gPrimePtr)
+{
+    double terme; //argument du logarithme
+    double g_de_x; //valeur finale
+
+    terme = rugRel/3.7 + 2.51*x/rey;
+    g_de_x = x + 2.0*log10(terme);
+    *gPrimePtr = 1 + 2.0*(2.51/rey)/(LN10*terme);
+
+    return(g_de_x);
+}
+
+/*-----------------------------------------------------------------------
+Fonction : calculSensibilites
+Paramtres :
+    f - facteur de friction, solution de Colebrook pour rey et eps/d
+    rey - nombre de Reynolds
+    eps - rugosit
+    d - diamtre
+    dfdDPtr - pointeur o crire df/dd,  nombre de Reynolds constant
+    dfdReyPtr - pointeur o crire df/drey
+    dfdEpsPtr - pointeur o crire df/deps
+Valeur de retour :  void
+
+Description : Cette fonction calcule les drives du facteur de friction par
+diffrentiation implicite de Colebrook, sans nouvelle rsolution. Puisque g(x, rey, r) = 0
+ la solution x = 1/sqrt(f), r = eps/d, on a dx/dp = -(dg/dp)/(dg/dx) pour chaque
+paramtre p, puis df/dp = -2*f^(3/2)*dx/dp. Avec t = r/3.7 + 2.51*x/rey :
+dg/dr = 2/(ln(10)*3.7*t) et dg/drey = -2*2.51*x/(ln(10)*rey^2*t). Enfin df/deps = (df/dr)/d
+et df/dd = -(df/dr)*eps/d^2  nombre de Reynolds constant. Si le nombre de Reynolds varie
+avec le diamtre, l'appelant ajoute (df/drey)*(drey/dd).
+------------------------------------------------------------------------*/
+void calculSensibilites(double f, double rey, double eps, double d, double *dfdDPtr, double *dfdReyPtr, double *dfdEpsPtr)
+{
+    double x = 1/sqrt(f);
+    double terme; //argument du logarithme
+    double gPrime; //drive dg/dx
+    double facteur; //-(df/dx)/(dg/dx) = 2*f^(3/2)/(dg/dx)
+    double dfdRug; //df/dr
+
+    calculColebrookX(x, rey, eps/d, &gPrime);
+    terme = eps/d/3.7 + 2.51*x/rey;
+    facteur = 2*f*sqrt(f)/gPrime;
+
+    dfdRug = facteur*2.0/(LN10*3.7*terme);
+    *dfdReyPtr = -facteur*2.0*2.51*x/(LN10*rey*rey*terme);
+    *dfdEpsPtr = dfdRug/d;
+    *dfdDPtr = -dfdRug*eps/(d*d);
+}
+
 /*-----------------------------------------------------------------------
 Fonction : plot
 Paramtres :
@@ -611,13 +5790,25 @@ Param
 Valeur de retour :  void
 
 Description : Cette fonction affiche le graphique du facteur de friction en fonction du diamtre.
+Aprs un balayage en flux, seuls les resPtr->nbrTraces points gards sont tracs et les
+chelles viennent des extrmes tenus pendant le calcul, sans autre passe sur les donnes.
 ------------------------------------------------------------------------*/
-void plot(DONNEES *dPtr)
+void plot(DONNEES *dPtr, RESULTATS *resPtr)
 {
     double miny, maxy;
+    int nbrPoints = dPtr->nbrPoints; //nombre de points tracs
 
-    miny = getMin(dPtr->ftbl); //min en y
-    maxy = getMax(dPtr->ftbl); //max en y
+    if(resPtr->nbrTraces > 0) //balayage en flux
+    {
+        nbrPoints = resPtr->nbrTraces;
+        miny = resPtr->fMin;
+        maxy = resPtr->fMax;
+    }
+    else
+    {
+        miny = getMin(dPtr->ftbl, dPtr->nbrPoints); //min en y
+        maxy = getMax(dPtr->ftbl, dPtr->nbrPoints); //max en y
+    }
 
     plsdev("wingcc");
     plinit(); //initialisation
@@ -631,7 +5822,7 @@ void plot(DONNEES *dPtr)
     pllab("Diametre (m)", "Facteur de friction", "Facteur de friction d'un conduit selon son diametre");
 
     plcol0(BLUE); //couleur de la plume pour la courbe
-    plline(TAILLE_MAX, dPtr->dtbl, dPtr->ftbl);
+    plline(nbrPoints, dPtr->dtbl, dPtr->ftbl);
 
     plend(); //ferme le graphique
 }
@@ -640,20 +5831,20 @@ void plot(DONNEES *dPtr)
 Fonction : getMin
 Paramtres :
     tbl - rfrence au tableau de facteur de friction
-Valeur de retour :  min - valeur minimale trouve.
+    taille - nombre de valeurs dans le tableau
+Valeur de retour :  min - valeur minimale trouve, 0 si aucune valeur n'est valide.
 
 Description : Cette fonction trouve la valeur minimale dans le tableau et retourne cette valeur.
+Les drapeaux ngatifs (IMPOSSIBLE, NON_CONVERGE) d'une coupe de grille sont ignors.
 ------------------------------------------------------------------------*/
-double getMin(double tbl[])
+double getMin(double tbl[], int taille)
 {
-    double min; //valeur minimale
+    double min = 0; //valeur minimale
     int ix; //index
 
-    min = tbl[0]; //assume que le 1er membre est le plus petit
-
-    for(ix = 1; ix< TAILLE_MAX; ix = ix + 1)
+    for(ix = 0; ix< taille; ix = ix + 1)
     {
-        if(tbl[ix] < min)
+        if(tbl[ix] >= 0 && (tbl[ix] < min || min == 0))
             min = tbl[ix];
     }
     return(min);
@@ -663,18 +5854,18 @@ double getMin(double tbl[])
 Fonction : getMax
 Paramtres :
     tbl - rfrence au tableau de facteur de friction
-Valeur de retour :  max - valeur maximale trouve
+    taille - nombre de valeurs dans le tableau
+Valeur de retour :  max - valeur maximale trouve, 0 si aucune valeur n'est valide
 
 Description : Cette fonction trouve la valeur maximale dans le tableau et retourne cette valeur.
+Les drapeaux ngatifs (IMPOSSIBLE, NON_CONVERGE) d'une coupe de grille sont ignors.
 ------------------------------------------------------------------------*/
-double getMax(double tbl[])
+double getMax(double tbl[], int taille)
 {
-    double max; //valeur maximale
+    double max = 0; //valeur maximale
     int ix; //index
 
-    max = tbl[0]; //assume que le 1er membre est le plus grand
-
-    for(ix = 1; ix< TAILLE_MAX; ix = ix + 1)
+    for(ix = 0; ix< taille; ix = ix + 1)
     {
         if(tbl[ix] > max)
             max = tbl[ix];